@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "volt/core/export.hpp"
+
+
+namespace volt::core {
+	/**
+	 * @brief A bump allocator whose allocations all live until the arena is destroyed
+	 *
+	 * Memory is taken from blocks of at least `blockSize` bytes. Allocations never move, and are
+	 * freed all at once.
+	 * */
+	class Arena final {
+		public:
+			static constexpr std::size_t DEFAULT_BLOCK_SIZE {64uz * 1024uz};
+
+			Arena(const Arena&) = delete;
+			auto operator=(const Arena&) -> Arena& = delete;
+			inline Arena(Arena&& other) noexcept :
+				m_blockSize {other.m_blockSize},
+				m_capacity {std::exchange(other.m_capacity, 0uz)},
+				m_cursor {std::exchange(other.m_cursor, nullptr)},
+				m_end {std::exchange(other.m_end, nullptr)},
+				m_blocks {std::move(other.m_blocks)}
+			{
+				other.m_blocks.clear();
+			}
+			inline auto operator=(Arena&& other) noexcept -> Arena& {
+				if (this == &other)
+					return *this;
+				m_blockSize = other.m_blockSize;
+				m_capacity = std::exchange(other.m_capacity, 0uz);
+				m_cursor = std::exchange(other.m_cursor, nullptr);
+				m_end = std::exchange(other.m_end, nullptr);
+				m_blocks = std::move(other.m_blocks);
+				other.m_blocks.clear();
+				return *this;
+			}
+
+			inline Arena(const std::size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept : m_blockSize {blockSize} {}
+			inline ~Arena() = default;
+
+			VOLT_CORE_EXPORT auto allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept
+				-> std::byte*;
+
+			//! total size of the blocks owned by the arena
+			inline auto getCapacity() const noexcept -> std::size_t {
+				return m_capacity;
+			}
+
+		private:
+			std::size_t m_blockSize;
+			std::size_t m_capacity {0uz};
+			std::byte* m_cursor {nullptr};
+			std::byte* m_end {nullptr};
+			std::vector<std::unique_ptr<std::byte[]>> m_blocks {};
+	};
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace volt::core {
+	/**
+	 * @brief A precompiled set of code points, used to search for any of them in an UTF-8 string
+	 *
+	 * ASCII code points are stored as nibble lookup tables (one bucket per high nibble), so that a
+	 * whole block of bytes can be classified with two shuffles. Other code points are stored in a
+	 * sorted array. The set can be built at compile time from a literal pattern.
+	 * */
+	class CharSet final {
+		public:
+			static constexpr std::size_t MAX_NON_ASCII_COUNT {32uz};
+
+			constexpr CharSet() noexcept = default;
+			constexpr CharSet(const std::u32string_view pattern) noexcept {
+				for (const char32_t character : pattern) {
+					[[maybe_unused]] const bool inserted {this->insert(character)};
+					assert(inserted && "Too many non-ASCII code points in CharSet pattern");
+				}
+			}
+			constexpr ~CharSet() = default;
+
+			constexpr auto insert(const char32_t character) noexcept -> bool {
+				if (character < 0x80) {
+					m_lowNibbles[character & 0x0f] |= static_cast<std::uint8_t> (1u << (character >> 4));
+					m_highNibbles[character >> 4] = static_cast<std::uint8_t> (1u << (character >> 4));
+					return true;
+				}
+				const auto end {m_nonAscii.begin() + m_nonAsciiCount};
+				const auto position {std::ranges::lower_bound(m_nonAscii.begin(), end, character)};
+				if (position != end && *position == character)
+					return true;
+				if (m_nonAsciiCount == MAX_NON_ASCII_COUNT)
+					return false;
+				std::ranges::move_backward(position, end, end + 1);
+				*position = character;
+				++m_nonAsciiCount;
+				return true;
+			}
+
+			constexpr auto contains(const char32_t character) const noexcept -> bool {
+				if (character < 0x80)
+					return (m_lowNibbles[character & 0x0f] & m_highNibbles[character >> 4]) != 0;
+				return std::ranges::binary_search(m_nonAscii.begin(), m_nonAscii.begin() + m_nonAsciiCount, character);
+			}
+			constexpr auto hasNonAscii() const noexcept -> bool {
+				return m_nonAsciiCount != 0uz;
+			}
+
+			constexpr auto getLowNibbles() const noexcept -> const std::array<std::uint8_t, 16uz>& {
+				return m_lowNibbles;
+			}
+			constexpr auto getHighNibbles() const noexcept -> const std::array<std::uint8_t, 16uz>& {
+				return m_highNibbles;
+			}
+
+		private:
+			std::array<std::uint8_t, 16uz> m_lowNibbles {};
+			std::array<std::uint8_t, 16uz> m_highNibbles {};
+			std::array<char32_t, MAX_NON_ASCII_COUNT> m_nonAscii {};
+			std::size_t m_nonAsciiCount {0uz};
+	};
+}
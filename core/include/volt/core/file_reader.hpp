@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <generator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "volt/core/export.hpp"
+#include "volt/core/thread_pool.hpp"
+
+
+namespace volt::core {
+	struct LoadedFile {
+		//! index of the file in the paths given to `FileReader::read`
+		std::size_t index;
+		//! empty if the file couldn't be read
+		std::optional<std::u8string> content;
+	};
+
+	struct FileReaderOptions {
+		//! maximum number of files being read at the same time
+		std::size_t queueDepth {64uz};
+		bool useIoUring {true};
+	};
+
+	/**
+	 * @brief Read many files at once, handing each of them out as soon as it has been read
+	 *
+	 * Reads are submitted in batches through io_uring when the kernel allows it. Otherwise they
+	 * are done with `pread` on the given thread pool. Files are yielded in completion order, so
+	 * the consumer can lex a file while the next ones are still being read.
+	 * */
+	class FileReader final {
+		public:
+			FileReader(const FileReader&) = delete;
+			auto operator=(const FileReader&) -> FileReader& = delete;
+			FileReader(FileReader&&) = delete;
+			auto operator=(FileReader&&) -> FileReader& = delete;
+
+			VOLT_CORE_EXPORT FileReader(core::ThreadPool& pool, const core::FileReaderOptions& options = {}) noexcept;
+			VOLT_CORE_EXPORT ~FileReader();
+
+			VOLT_CORE_EXPORT auto read(std::span<const std::filesystem::path> paths) noexcept
+				-> std::generator<core::LoadedFile>;
+
+			inline auto isUsingIoUring() const noexcept -> bool {
+				return m_ring != nullptr;
+			}
+
+		private:
+			struct Ring;
+
+			auto readWithRing(std::span<const std::filesystem::path> paths) noexcept -> std::generator<core::LoadedFile>;
+			auto readWithPool(
+				std::span<const std::filesystem::path> paths,
+				std::vector<std::size_t> retriedIndices,
+				std::size_t nextPath
+			) noexcept -> std::generator<core::LoadedFile>;
+
+			core::ThreadPool& m_pool;
+			core::FileReaderOptions m_options;
+			std::unique_ptr<Ring> m_ring;
+	};
+}
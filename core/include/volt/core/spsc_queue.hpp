@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+
+namespace volt::core {
+	/**
+	 * @brief A bounded lock-free queue with a single producer and a single consumer
+	 *
+	 * `push` blocks while the queue is full and `pop` blocks while it is empty. Any side can `close`
+	 * the queue: the consumer still gets the remaining elements, while the producer can't push anymore.
+	 * */
+	template <typename T, std::size_t Capacity>
+	requires (std::has_single_bit(Capacity) && std::is_default_constructible_v<T> && std::is_move_assignable_v<T>)
+	class SpscQueue final {
+		public:
+			SpscQueue(const SpscQueue&) = delete;
+			auto operator=(const SpscQueue&) -> SpscQueue& = delete;
+			SpscQueue(SpscQueue&&) = delete;
+			auto operator=(SpscQueue&&) -> SpscQueue& = delete;
+
+			constexpr SpscQueue() noexcept = default;
+			constexpr ~SpscQueue() = default;
+
+			auto push(T&& value) noexcept -> bool {
+				const std::size_t tail {m_tail.load(std::memory_order_relaxed) & ~CLOSED_BIT};
+				std::size_t head {m_head.load(std::memory_order_acquire)};
+				while ((head & CLOSED_BIT) == 0uz && tail - head == Capacity) {
+					m_head.wait(head, std::memory_order_acquire);
+					head = m_head.load(std::memory_order_acquire);
+				}
+				if ((head & CLOSED_BIT) != 0uz)
+					return false;
+
+				m_slots[tail & (Capacity - 1uz)] = std::move(value);
+				m_tail.fetch_add(1uz, std::memory_order_release);
+				m_tail.notify_one();
+				return true;
+			}
+
+			auto pop() noexcept -> std::optional<T> {
+				const std::size_t head {m_head.load(std::memory_order_relaxed) & ~CLOSED_BIT};
+				std::size_t tail {m_tail.load(std::memory_order_acquire)};
+				while ((tail & ~CLOSED_BIT) == head) {
+					if ((tail & CLOSED_BIT) != 0uz)
+						return std::nullopt;
+					m_tail.wait(tail, std::memory_order_acquire);
+					tail = m_tail.load(std::memory_order_acquire);
+				}
+
+				std::optional<T> value {std::move(m_slots[head & (Capacity - 1uz)])};
+				m_head.fetch_add(1uz, std::memory_order_release);
+				m_head.notify_one();
+				return value;
+			}
+
+			auto close() noexcept -> void {
+				m_head.fetch_or(CLOSED_BIT, std::memory_order_acq_rel);
+				m_tail.fetch_or(CLOSED_BIT, std::memory_order_acq_rel);
+				m_head.notify_all();
+				m_tail.notify_all();
+			}
+
+		private:
+			// the closed state is stored in both indices, so that closing wakes up any waiting side
+			static constexpr std::size_t CLOSED_BIT {1uz << 63uz};
+			static constexpr std::size_t CACHE_LINE_SIZE {64uz};
+
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head {0uz};
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail {0uz};
+			std::array<T, Capacity> m_slots {};
+	};
+}
@@ -6,6 +6,7 @@
 #include <string_view>
 #include <tuple>
 
+#include "volt/core/char_set.hpp"
 #include "volt/core/export.hpp"
 
 
@@ -15,6 +16,16 @@ namespace volt::core {
 	VOLT_CORE_EXPORT auto iterativeUtf8ToUtf32(std::u8string_view characters) noexcept
 		-> std::optional<std::pair<char32_t, std::u8string_view>>;
 	VOLT_CORE_EXPORT auto isSameCodePoint(std::u8string_view lhs, std::u8string_view rhs) noexcept -> bool;
+	VOLT_CORE_EXPORT auto getIncompleteUtf8SuffixSize(std::u8string_view characters) noexcept -> std::size_t;
+	VOLT_CORE_EXPORT auto isAscii(std::u8string_view characters) noexcept -> bool;
+	/**
+	 * @brief Find the first `delimiter` that isn't escaped by a backslash
+	 *
+	 * The start of `string` must not be escaped. A backslash escapes the byte right after it,
+	 * including another backslash.
+	 * */
+	VOLT_CORE_EXPORT auto findUnescaped(std::u8string_view string, char8_t delimiter) noexcept
+		-> std::optional<std::size_t>;
 
 	struct Utf32ConverterView : std::ranges::range_adaptor_closure<Utf32ConverterView> {
 		VOLT_CORE_EXPORT auto operator()(std::u8string_view string) const noexcept -> std::generator<char32_t>;
@@ -26,9 +37,13 @@ namespace volt::core {
 	};
 	constexpr core::EnumerateUtf32ConverterView enumerate_utf32_converter_view {};
 
+	VOLT_CORE_EXPORT auto startWithAnyOf(std::u8string_view string, const core::CharSet& pattern) noexcept
+		-> std::optional<std::u8string_view>;
 	VOLT_CORE_EXPORT auto startWithAnyOf(std::u8string_view string, std::u32string_view pattern) noexcept
 		-> std::optional<std::u8string_view>;
 
+	VOLT_CORE_EXPORT auto findAnyOf(std::u8string_view string, const core::CharSet& pattern) noexcept
+		-> std::optional<std::pair<std::size_t, std::size_t>>;
 	VOLT_CORE_EXPORT auto findAnyOf(std::u8string_view string, std::u8string_view pattern) noexcept
 		-> std::optional<std::pair<std::size_t, std::size_t>>;
 	VOLT_CORE_EXPORT auto findAnyOf(std::u8string_view string, std::u32string_view pattern) noexcept
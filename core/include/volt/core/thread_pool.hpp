@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "volt/core/export.hpp"
+
+
+namespace volt::core {
+	class ThreadPool final {
+		public:
+			ThreadPool(const ThreadPool&) = delete;
+			auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+			ThreadPool(ThreadPool&&) = delete;
+			auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+			VOLT_CORE_EXPORT ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency()) noexcept;
+			VOLT_CORE_EXPORT ~ThreadPool();
+
+			template <typename Func>
+			requires std::is_invocable_v<Func>
+			auto submit(Func&& func) noexcept -> std::future<std::invoke_result_t<Func>> {
+				std::packaged_task<std::invoke_result_t<Func> ()> task {std::forward<Func> (func)};
+				auto future {task.get_future()};
+				this->push(std::move(task));
+				return future;
+			}
+
+			inline auto getThreadCount() const noexcept -> std::size_t {
+				return m_threads.size();
+			}
+
+		private:
+			VOLT_CORE_EXPORT auto push(std::move_only_function<void()>&& job) noexcept -> void;
+			auto work(std::stop_token stopToken) noexcept -> void;
+
+			std::mutex m_mutex;
+			std::condition_variable_any m_condition;
+			std::queue<std::move_only_function<void()>> m_jobs;
+			std::vector<std::jthread> m_threads;
+	};
+}
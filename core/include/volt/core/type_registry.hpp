@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <generator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "volt/core/export.hpp"
+
+
+namespace volt::core {
+	struct TypeDescriptor {
+		std::size_t UUID;
+		std::u8string identifier;
+	};
+
+	/**
+	 * @brief A registry handing out type UUIDs, that can be shared between threads
+	 *
+	 * Lookups never lock. Inserts only lock one of the shards, chosen by the hash of the identifier.
+	 * UUIDs are allocated densely in insertion order, which is also the order used to iterate on the
+	 * registered types. `get` resolves a UUID as soon as its type is stored, but a type is only
+	 * published to `getTypes` and `getCount` once all the types with a smaller UUID are, so that each
+	 * iteration sees a prefix of the next ones. Descriptors are never moved, so references to them
+	 * stay valid as long as the registry lives.
+	 * */
+	class TypeRegistry final {
+		public:
+			TypeRegistry(const TypeRegistry&) = delete;
+			auto operator=(const TypeRegistry&) -> TypeRegistry& = delete;
+			TypeRegistry(TypeRegistry&&) = delete;
+			auto operator=(TypeRegistry&&) -> TypeRegistry& = delete;
+
+			VOLT_CORE_EXPORT TypeRegistry() noexcept;
+			VOLT_CORE_EXPORT ~TypeRegistry();
+
+			VOLT_CORE_EXPORT auto intern(std::u8string_view identifier) noexcept -> const core::TypeDescriptor&;
+			VOLT_CORE_EXPORT auto find(std::u8string_view identifier) const noexcept -> const core::TypeDescriptor*;
+			VOLT_CORE_EXPORT auto get(std::size_t UUID) const noexcept -> const core::TypeDescriptor*;
+			VOLT_CORE_EXPORT auto getTypes() const noexcept -> std::generator<const core::TypeDescriptor&>;
+
+			inline auto getCount() const noexcept -> std::size_t {
+				return m_publishedCount.load(std::memory_order_acquire);
+			}
+
+		private:
+			static constexpr std::size_t SHARD_COUNT {16uz};
+			static constexpr std::size_t FIRST_SEGMENT_SIZE {64uz};
+			static constexpr std::size_t SEGMENT_COUNT {48uz};
+
+			struct Table {
+				std::size_t capacity;
+				std::size_t count;
+				std::unique_ptr<std::atomic<const core::TypeDescriptor*>[]> slots;
+			};
+			struct Shard {
+				std::mutex insertMutex;
+				std::atomic<Table*> table;
+				std::vector<std::unique_ptr<Table>> tables;
+			};
+
+			static auto findInTable(const Table& table, std::u8string_view identifier, std::size_t hash) noexcept
+				-> const core::TypeDescriptor*;
+			static auto insertInTable(Table& table, const core::TypeDescriptor& descriptor, std::size_t hash) noexcept
+				-> void;
+			auto getSlot(std::size_t UUID) noexcept -> std::atomic<const core::TypeDescriptor*>&;
+			auto loadSlot(std::size_t UUID) const noexcept -> const core::TypeDescriptor*;
+			auto publish() noexcept -> void;
+
+			std::array<Shard, SHARD_COUNT> m_shards;
+			std::array<std::atomic<std::atomic<const core::TypeDescriptor*>*>, SEGMENT_COUNT> m_segments;
+			//! number of allocated UUIDs
+			std::atomic<std::size_t> m_count;
+			//! number of UUIDs whose slot, and the slots of all the smaller UUIDs, are filled
+			std::atomic<std::size_t> m_publishedCount;
+	};
+}
@@ -0,0 +1,30 @@
+#include "volt/core/arena.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+
+namespace volt::core {
+	auto Arena::allocate(const std::size_t size, const std::size_t alignment) noexcept -> std::byte* {
+		assert(std::has_single_bit(alignment));
+		const auto align {[alignment] (std::byte* pointer) {
+			const auto address {reinterpret_cast<std::uintptr_t> (pointer)};
+			return pointer + ((alignment - address % alignment) % alignment);
+		}};
+
+		std::byte* allocation {m_cursor == nullptr ? nullptr : align(m_cursor)};
+		if (allocation == nullptr || allocation + size > m_end) {
+			// oversized allocations get a block of their own
+			const std::size_t blockSize {std::max(m_blockSize, size + alignment)};
+			auto& block {m_blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]> (blockSize))};
+			m_capacity += blockSize;
+			m_end = block.get() + blockSize;
+			allocation = align(block.get());
+		}
+		m_cursor = allocation + size;
+		return allocation;
+	}
+}
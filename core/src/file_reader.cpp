@@ -0,0 +1,465 @@
+#include "volt/core/file_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+		#define VOLT_CORE_HAS_IO_URING
+	#endif
+#endif
+
+#include "volt/core/janitor.hpp"
+
+
+namespace volt::core {
+	namespace {
+		struct OpenedFile {
+			int descriptor;
+			std::size_t size;
+		};
+
+		auto openFile(const std::filesystem::path& path) noexcept -> std::optional<OpenedFile> {
+			const int descriptor {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+			if (descriptor < 0)
+				return std::nullopt;
+			struct stat status {};
+			if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+				::close(descriptor);
+				return std::nullopt;
+			}
+			return OpenedFile{.descriptor = descriptor, .size = static_cast<std::size_t> (status.st_size)};
+		}
+
+		auto readWholeFile(const std::filesystem::path& path) noexcept -> std::optional<std::u8string> {
+			const std::optional<OpenedFile> file {openFile(path)};
+			if (!file)
+				return std::nullopt;
+			core::Janitor _ {[descriptor = file->descriptor] () noexcept {::close(descriptor);}};
+
+			std::u8string content {};
+			content.resize(file->size);
+			std::size_t offset {0uz};
+			while (offset < content.size()) {
+				const ::ssize_t size {::pread(
+					file->descriptor, content.data() + offset, content.size() - offset, static_cast<::off_t> (offset)
+				)};
+				if (size < 0 && errno == EINTR)
+					continue;
+				if (size < 0)
+					return std::nullopt;
+				// the file shrank since it was opened
+				if (size == 0)
+					break;
+				offset += static_cast<std::size_t> (size);
+			}
+			content.resize(offset);
+			return content;
+		}
+	}
+
+
+#ifdef VOLT_CORE_HAS_IO_URING
+	/*
+	 * A minimal io_uring binding over the raw syscalls, so that liburing isn't needed. Only one
+	 * thread uses the ring at a time, the atomics only synchronise with the kernel.
+	 * */
+	struct FileReader::Ring {
+		struct Completion {
+			std::uint64_t userData;
+			std::int32_t result;
+		};
+
+		int descriptor;
+		unsigned int pendingCount;
+		void* submissionRing;
+		std::size_t submissionRingSize;
+		void* completionRing;
+		std::size_t completionRingSize;
+		io_uring_sqe* entries;
+		std::size_t entriesSize;
+		unsigned int* submissionHead;
+		unsigned int* submissionTail;
+		unsigned int submissionMask;
+		unsigned int submissionCount;
+		unsigned int* submissionArray;
+		unsigned int* completionHead;
+		unsigned int* completionTail;
+		unsigned int completionMask;
+		io_uring_cqe* completions;
+
+		// `IORING_OP_READ` only exists since Linux 5.6, older kernels create the ring but fail every read.
+		// Probing was added in the same version
+		static auto supportsRead(const int descriptor) noexcept -> bool {
+			constexpr std::size_t OPERATION_COUNT {256uz};
+			// the kernel requires the probe to be zeroed
+			std::vector<std::byte> buffer {};
+			buffer.resize(sizeof(io_uring_probe) + OPERATION_COUNT * sizeof(io_uring_probe_op));
+			auto* const probe {reinterpret_cast<io_uring_probe*> (buffer.data())};
+			if (::syscall(__NR_io_uring_register, descriptor, IORING_REGISTER_PROBE, probe, OPERATION_COUNT) < 0)
+				return false;
+			return IORING_OP_READ <= probe->last_op
+				&& (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0u;
+		}
+
+		static auto create(const unsigned int entryCount) noexcept -> std::unique_ptr<Ring> {
+			io_uring_params parameters {};
+			const int descriptor {static_cast<int> (::syscall(__NR_io_uring_setup, entryCount, &parameters))};
+			// the kernel may be too old, or io_uring may be disabled by a sandbox
+			if (descriptor < 0)
+				return nullptr;
+			if (!supportsRead(descriptor)) {
+				::close(descriptor);
+				return nullptr;
+			}
+
+			auto ring {std::make_unique<Ring> ()};
+			ring->descriptor = descriptor;
+			ring->pendingCount = 0u;
+			ring->submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned int);
+			ring->completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+			ring->entriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+			const bool isSingleMapping {(parameters.features & IORING_FEAT_SINGLE_MMAP) != 0u};
+			if (isSingleMapping) {
+				ring->submissionRingSize = std::max(ring->submissionRingSize, ring->completionRingSize);
+				ring->completionRingSize = ring->submissionRingSize;
+			}
+
+			const auto map {[descriptor] (const std::size_t size, const off_t offset) noexcept -> void* {
+				void* mapping {::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, offset)};
+				return mapping == MAP_FAILED ? nullptr : mapping;
+			}};
+			ring->submissionRing = map(ring->submissionRingSize, IORING_OFF_SQ_RING);
+			ring->completionRing = isSingleMapping
+				? ring->submissionRing
+				: map(ring->completionRingSize, IORING_OFF_CQ_RING);
+			ring->entries = static_cast<io_uring_sqe*> (map(ring->entriesSize, IORING_OFF_SQES));
+			if (ring->submissionRing == nullptr || ring->completionRing == nullptr || ring->entries == nullptr)
+				return nullptr;
+
+			auto* const submission {static_cast<std::byte*> (ring->submissionRing)};
+			ring->submissionHead = reinterpret_cast<unsigned int*> (submission + parameters.sq_off.head);
+			ring->submissionTail = reinterpret_cast<unsigned int*> (submission + parameters.sq_off.tail);
+			ring->submissionMask = *reinterpret_cast<unsigned int*> (submission + parameters.sq_off.ring_mask);
+			ring->submissionCount = parameters.sq_entries;
+			ring->submissionArray = reinterpret_cast<unsigned int*> (submission + parameters.sq_off.array);
+			auto* const completion {static_cast<std::byte*> (ring->completionRing)};
+			ring->completionHead = reinterpret_cast<unsigned int*> (completion + parameters.cq_off.head);
+			ring->completionTail = reinterpret_cast<unsigned int*> (completion + parameters.cq_off.tail);
+			ring->completionMask = *reinterpret_cast<unsigned int*> (completion + parameters.cq_off.ring_mask);
+			ring->completions = reinterpret_cast<io_uring_cqe*> (completion + parameters.cq_off.cqes);
+			return ring;
+		}
+
+		~Ring() {
+			if (entries != nullptr)
+				::munmap(entries, entriesSize);
+			if (completionRing != nullptr && completionRing != submissionRing)
+				::munmap(completionRing, completionRingSize);
+			if (submissionRing != nullptr)
+				::munmap(submissionRing, submissionRingSize);
+			::close(descriptor);
+		}
+
+		auto pushRead(
+			const int fileDescriptor,
+			char8_t* buffer,
+			const std::size_t size,
+			const std::size_t offset,
+			const std::uint64_t userData
+		) noexcept -> void {
+			// the length of a single read is 32 bits wide, bigger files are read in several steps
+			constexpr std::size_t MAX_READ_SIZE {1uz << 30uz};
+			const unsigned int tail {*submissionTail};
+			assert(tail - std::atomic_ref<unsigned int> {*submissionHead}.load(std::memory_order_acquire) < submissionCount);
+			const unsigned int index {tail & submissionMask};
+			io_uring_sqe& entry {entries[index]};
+			std::memset(&entry, 0, sizeof(entry));
+			entry.opcode = IORING_OP_READ;
+			entry.fd = fileDescriptor;
+			entry.addr = reinterpret_cast<std::uint64_t> (buffer);
+			entry.len = static_cast<std::uint32_t> (std::min(size, MAX_READ_SIZE));
+			entry.off = offset;
+			entry.user_data = userData;
+			submissionArray[index] = index;
+			std::atomic_ref<unsigned int> {*submissionTail}.store(tail + 1u, std::memory_order_release);
+			++pendingCount;
+		}
+
+		auto submitAndWait() noexcept -> bool {
+			while (true) {
+				const long submitted {::syscall(
+					__NR_io_uring_enter, descriptor, pendingCount, 1u, IORING_ENTER_GETEVENTS, nullptr, 0uz
+				)};
+				if (submitted >= 0) {
+					pendingCount -= static_cast<unsigned int> (submitted);
+					return true;
+				}
+				if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+					return false;
+			}
+		}
+
+		// the kernel only consumes the submission queue when entering the ring, so the entries it didn't
+		// take yet can be removed. Returns their user data
+		auto takeBackPending() noexcept -> std::vector<std::uint64_t> {
+			const unsigned int head {std::atomic_ref<unsigned int> {*submissionHead}.load(std::memory_order_acquire)};
+			const unsigned int tail {*submissionTail};
+			std::vector<std::uint64_t> userData {};
+			for (unsigned int index {head}; index != tail; ++index)
+				userData.push_back(entries[submissionArray[index & submissionMask]].user_data);
+			std::atomic_ref<unsigned int> {*submissionTail}.store(head, std::memory_order_release);
+			pendingCount = 0u;
+			return userData;
+		}
+
+		// the kernel posts the completions even if entering the ring fails, in which case the ring is polled
+		auto waitCompletion() noexcept -> Completion {
+			while (true) {
+				if (const std::optional completion {this->popCompletion()})
+					return *completion;
+				if (::syscall(__NR_io_uring_enter, descriptor, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0uz) < 0)
+					std::this_thread::yield();
+			}
+		}
+
+		auto popCompletion() noexcept -> std::optional<Completion> {
+			const unsigned int head {*completionHead};
+			if (head == std::atomic_ref<unsigned int> {*completionTail}.load(std::memory_order_acquire))
+				return std::nullopt;
+			const io_uring_cqe& completion {completions[head & completionMask]};
+			const Completion result {.userData = completion.user_data, .result = completion.res};
+			std::atomic_ref<unsigned int> {*completionHead}.store(head + 1u, std::memory_order_release);
+			return result;
+		}
+	};
+#else
+	struct FileReader::Ring {
+		static auto create(unsigned int) noexcept -> std::unique_ptr<Ring> {
+			return nullptr;
+		}
+	};
+#endif
+
+
+	FileReader::FileReader(core::ThreadPool& pool, const core::FileReaderOptions& options) noexcept :
+		m_pool {pool},
+		m_options {options},
+		m_ring {nullptr}
+	{
+		m_options.queueDepth = std::max(m_options.queueDepth, 1uz);
+		if (m_options.useIoUring)
+			m_ring = Ring::create(static_cast<unsigned int> (m_options.queueDepth));
+	}
+
+	FileReader::~FileReader() = default;
+
+	auto FileReader::read(const std::span<const std::filesystem::path> paths) noexcept
+		-> std::generator<core::LoadedFile>
+	{
+		if (m_ring != nullptr)
+			return this->readWithRing(paths);
+		return this->readWithPool(paths, {}, 0uz);
+	}
+
+	auto FileReader::readWithRing(const std::span<const std::filesystem::path> paths) noexcept
+		-> std::generator<core::LoadedFile>
+	{
+	#ifdef VOLT_CORE_HAS_IO_URING
+		struct Read {
+			std::size_t index;
+			int descriptor;
+			std::u8string content;
+			std::size_t offset;
+		};
+
+		std::vector<Read> reads {};
+		reads.resize(m_options.queueDepth);
+		std::vector<std::size_t> freeSlots {};
+		for (std::size_t slot {reads.size()}; slot > 0uz; --slot)
+			freeSlots.push_back(slot - 1uz);
+		std::vector<core::LoadedFile> completedFiles {};
+		std::size_t nextPath {0uz};
+		std::size_t inFlightCount {0uz};
+
+		const auto pushRead {[this, &reads] (const std::size_t slot) noexcept {
+			Read& read {reads[slot]};
+			m_ring->pushRead(read.descriptor, read.content.data() + read.offset, read.content.size() - read.offset,
+				read.offset, slot
+			);
+		}};
+		const auto completeRead {[&] (const std::size_t slot, std::optional<std::u8string>&& content) noexcept {
+			::close(reads[slot].descriptor);
+			completedFiles.push_back({.index = reads[slot].index, .content = std::move(content)});
+			freeSlots.push_back(slot);
+			--inFlightCount;
+		}};
+		// the kernel may still write in the buffers of the reads in flight if the consumer stops early
+		core::Janitor _ {[&] () noexcept {
+			if (inFlightCount == 0uz)
+				return;
+			for (const std::uint64_t userData : m_ring->takeBackPending()) {
+				::close(reads[userData].descriptor);
+				--inFlightCount;
+			}
+			for (; inFlightCount != 0uz; --inFlightCount)
+				::close(reads[m_ring->waitCompletion().userData].descriptor);
+		}};
+
+		while (nextPath < paths.size() || inFlightCount != 0uz || !completedFiles.empty()) {
+			for (; nextPath < paths.size() && !freeSlots.empty(); ++nextPath) {
+				const std::optional<OpenedFile> file {openFile(paths[nextPath])};
+				if (!file) {
+					completedFiles.push_back({.index = nextPath, .content = std::nullopt});
+					continue;
+				}
+				if (file->size == 0uz) {
+					::close(file->descriptor);
+					completedFiles.push_back({.index = nextPath, .content = std::u8string{}});
+					continue;
+				}
+
+				const std::size_t slot {freeSlots.back()};
+				freeSlots.pop_back();
+				reads[slot] = Read{.index = nextPath, .descriptor = file->descriptor, .content = {}, .offset = 0uz};
+				reads[slot].content.resize(file->size);
+				pushRead(slot);
+				++inFlightCount;
+			}
+
+			for (auto& file : completedFiles)
+				co_yield std::move(file);
+			completedFiles.clear();
+			if (inFlightCount == 0uz)
+				continue;
+
+			if (!m_ring->submitAndWait()) {
+				// the reads the kernel already took must complete before their buffers are freed. The
+				// ones that didn't finish are read again by the pool, along with the next files
+				std::vector<std::size_t> retriedIndices {};
+				const auto retryRead {[&] (const std::size_t slot) noexcept {
+					::close(reads[slot].descriptor);
+					retriedIndices.push_back(reads[slot].index);
+					freeSlots.push_back(slot);
+					--inFlightCount;
+				}};
+				for (const std::uint64_t userData : m_ring->takeBackPending())
+					retryRead(static_cast<std::size_t> (userData));
+				while (inFlightCount != 0uz) {
+					const Ring::Completion completion {m_ring->waitCompletion()};
+					const auto slot {static_cast<std::size_t> (completion.userData)};
+					Read& read {reads[slot]};
+					const bool isComplete {completion.result >= 0
+						&& read.offset + static_cast<std::size_t> (completion.result) == read.content.size()
+					};
+					if (!isComplete) {
+						retryRead(slot);
+						continue;
+					}
+					completeRead(slot, std::move(read.content));
+				}
+				m_ring.reset();
+
+				for (auto& file : completedFiles)
+					co_yield std::move(file);
+				completedFiles.clear();
+				co_yield std::ranges::elements_of(this->readWithPool(paths, std::move(retriedIndices), nextPath));
+				co_return;
+			}
+
+			while (const std::optional completion {m_ring->popCompletion()}) {
+				const auto slot {static_cast<std::size_t> (completion->userData)};
+				Read& read {reads[slot]};
+				if (completion->result == -EINTR || completion->result == -EAGAIN) {
+					pushRead(slot);
+					continue;
+				}
+				if (completion->result < 0) {
+					completeRead(slot, std::nullopt);
+					continue;
+				}
+
+				read.offset += static_cast<std::size_t> (completion->result);
+				if (completion->result != 0 && read.offset < read.content.size()) {
+					pushRead(slot);
+					continue;
+				}
+				// a read of 0 bytes means that the file shrank since it was opened
+				read.content.resize(read.offset);
+				completeRead(slot, std::move(read.content));
+			}
+		}
+	#else
+		(void)paths;
+		co_return;
+	#endif
+	}
+
+	auto FileReader::readWithPool(
+		const std::span<const std::filesystem::path> paths,
+		std::vector<std::size_t> retriedIndices,
+		std::size_t nextPath
+	) noexcept -> std::generator<core::LoadedFile> {
+		// shared with the jobs, which may outlive the generator if the consumer stops early
+		struct State {
+			std::mutex mutex;
+			std::condition_variable condition;
+			std::vector<core::LoadedFile> completedFiles;
+		};
+		const auto state {std::make_shared<State> ()};
+
+		// the files given back by the ring are read first, then the ones it didn't reach
+		std::size_t nextRetried {0uz};
+		const auto hasNextFile {[&] () noexcept {
+			return nextRetried < retriedIndices.size() || nextPath < paths.size();
+		}};
+		const auto takeNextFile {[&] () noexcept -> std::size_t {
+			if (nextRetried < retriedIndices.size())
+				return retriedIndices[nextRetried++];
+			return nextPath++;
+		}};
+
+		std::size_t inFlightCount {0uz};
+		std::vector<core::LoadedFile> completedFiles {};
+		while (hasNextFile() || inFlightCount != 0uz) {
+			for (; hasNextFile() && inFlightCount < m_options.queueDepth; ++inFlightCount) {
+				const std::size_t index {takeNextFile()};
+				m_pool.submit([state, index, path = paths[index]] () noexcept {
+					core::LoadedFile file {.index = index, .content = readWholeFile(path)};
+					{
+						std::scoped_lock _ {state->mutex};
+						state->completedFiles.push_back(std::move(file));
+					}
+					state->condition.notify_one();
+				});
+			}
+
+			{
+				std::unique_lock lock {state->mutex};
+				state->condition.wait(lock, [&state] {return !state->completedFiles.empty();});
+				std::swap(completedFiles, state->completedFiles);
+			}
+			inFlightCount -= completedFiles.size();
+			for (auto& file : completedFiles)
+				co_yield std::move(file);
+			completedFiles.clear();
+		}
+	}
+}
@@ -1,13 +1,35 @@
 #include "volt/core/string.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <optional>
 #include <ranges>
+#include <string>
 #include <string_view>
 #include <tuple>
 
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+#endif
+
 
 namespace volt::core {
+	namespace {
+		auto getUtf8SequenceSize(const char8_t leadingByte) noexcept -> std::size_t {
+			if ((leadingByte & 0b1000'0000) == 0)
+				return 1uz;
+			else if ((leadingByte & 0b1110'0000) == 0b1100'0000)
+				return 2uz;
+			else if ((leadingByte & 0b1111'0000) == 0b1110'0000)
+				return 3uz;
+			else
+				return 4uz;
+		}
+	}
+
+
 	auto utf8ToUtf32(const std::u8string_view characters) noexcept -> std::optional<char32_t> {
 		if (characters.empty()) [[unlikely]]
 			return std::nullopt;
@@ -110,42 +132,234 @@ namespace volt::core {
 		return *lhsAsUtf32 == *rhsAsUtf32;
 	}
 
+	auto getIncompleteUtf8SuffixSize(const std::u8string_view characters) noexcept -> std::size_t {
+		for (std::size_t i {1uz}; i <= std::min(characters.size(), 3uz); ++i) {
+			const char8_t character {characters[characters.size() - i]};
+			if ((character & 0b1100'0000) == 0b1000'0000)
+				continue;
+			const std::size_t sequenceSize {getUtf8SequenceSize(character)};
+			return sequenceSize > i ? i : 0uz;
+		}
+		return 0uz;
+	}
+
+	auto isAscii(const std::u8string_view characters) noexcept -> bool {
+		std::size_t index {0uz};
+	#if defined(__SSE2__)
+		__m128i accumulator {_mm_setzero_si128()};
+		for (; index + 16uz <= characters.size(); index += 16uz) {
+			const __m128i block {_mm_loadu_si128(reinterpret_cast<const __m128i*> (characters.data() + index))};
+			accumulator = _mm_or_si128(accumulator, block);
+		}
+		if (_mm_movemask_epi8(accumulator) != 0)
+			return false;
+	#endif
+		for (; index < characters.size(); ++index) {
+			if (characters[index] >= 0x80)
+				return false;
+		}
+		return true;
+	}
+
+	namespace {
+	#if defined(__SSE2__)
+		auto getByteMask(const char8_t* block, const __m128i byte) noexcept -> std::uint64_t {
+			std::uint64_t mask {0u};
+			for (std::size_t i {0uz}; i < 4uz; ++i) {
+				const __m128i part {_mm_loadu_si128(reinterpret_cast<const __m128i*> (block + i * 16uz))};
+				mask |= static_cast<std::uint64_t> (static_cast<std::uint16_t> (_mm_movemask_epi8(_mm_cmpeq_epi8(part, byte))))
+					<< (i * 16uz);
+			}
+			return mask;
+		}
+
+		/*
+		 * Computes which bytes of a 64 bytes block are escaped, without walking the runs of
+		 * backslashes. A run escapes the byte after it iff its length is odd, ie iff its start and
+		 * end have different parities. Adding the starts of the runs beginning on odd bits to the
+		 * backslashes carries through each run, which leaves the bit after the end set.
+		 * `isEscaped` carries the escape of the first byte of the next block.
+		 * */
+		auto getEscapedMask(std::uint64_t backslashes, std::uint64_t& isEscaped) noexcept -> std::uint64_t {
+			constexpr std::uint64_t EVEN_BITS {0x5555'5555'5555'5555u};
+			backslashes &= ~isEscaped;
+			const std::uint64_t followsBackslash {(backslashes << 1u) | isEscaped};
+			const std::uint64_t oddRunStarts {backslashes & ~EVEN_BITS & ~followsBackslash};
+			std::uint64_t evenRunEnds {};
+			isEscaped = __builtin_add_overflow(oddRunStarts, backslashes, &evenRunEnds) ? 1u : 0u;
+			return (EVEN_BITS ^ (evenRunEnds << 1u)) & followsBackslash;
+		}
+	#endif
+	}
+
+
+	auto findUnescaped(const std::u8string_view string, const char8_t delimiter) noexcept
+		-> std::optional<std::size_t>
+	{
+		assert(delimiter != u8'\\');
+		std::size_t index {0uz};
+		bool isEscaped {false};
+	#if defined(__SSE2__)
+		const __m128i delimiterByte {_mm_set1_epi8(static_cast<char> (delimiter))};
+		const __m128i backslashByte {_mm_set1_epi8('\\')};
+		std::uint64_t blockEscape {0u};
+		for (; index + 64uz <= string.size(); index += 64uz) {
+			const std::uint64_t delimiters {getByteMask(string.data() + index, delimiterByte)};
+			const std::uint64_t backslashes {getByteMask(string.data() + index, backslashByte)};
+			const std::uint64_t unescaped {delimiters & ~getEscapedMask(backslashes, blockEscape)};
+			if (unescaped != 0u)
+				return index + static_cast<std::size_t> (std::countr_zero(unescaped));
+		}
+		isEscaped = blockEscape != 0u;
+	#endif
+		for (; index < string.size(); ++index) {
+			if (isEscaped)
+				isEscaped = false;
+			else if (string[index] == delimiter)
+				return index;
+			else if (string[index] == u8'\\')
+				isEscaped = true;
+		}
+		return std::nullopt;
+	}
+
+
+	namespace {
+		/*
+		 * Checks whether the byte at `index` starts a code point of the set. Continuation bytes never
+		 * match, so that the search can test every byte flagged by the block scanner.
+		 * */
+		auto matchAt(const std::u8string_view string, const std::size_t index, const core::CharSet& pattern) noexcept
+			-> std::optional<std::pair<std::size_t, std::size_t>>
+		{
+			const char8_t byte {string[index]};
+			if (byte < 0x80) {
+				if (pattern.contains(static_cast<char32_t> (byte)))
+					return std::make_pair(index, 1uz);
+				return std::nullopt;
+			}
+			if ((byte & 0b1100'0000) == 0b1000'0000)
+				return std::nullopt;
+			const std::optional<char32_t> utf32 {core::utf8ToUtf32(string.substr(index))};
+			if (!utf32 || !pattern.contains(*utf32))
+				return std::nullopt;
+			return std::make_pair(index, getUtf8SequenceSize(byte));
+		}
+
+		auto findAnyOfLinear(const std::u8string_view string, const std::u32string_view pattern) noexcept
+			-> std::optional<std::pair<std::size_t, std::size_t>>
+		{
+			for (const auto& [index, size, utf32] : string | core::enumerate_utf32_converter_view) {
+				if (pattern.contains(utf32))
+					return std::make_pair(index, size);
+			}
+			return std::nullopt;
+		}
+
+		auto findAnyOfScalar(const std::u8string_view string, std::size_t index, const core::CharSet& pattern) noexcept
+			-> std::optional<std::pair<std::size_t, std::size_t>>
+		{
+			for (; index < string.size(); ++index) {
+				if (string[index] >= 0x80 && !pattern.hasNonAscii())
+					continue;
+				if (const auto match {matchAt(string, index, pattern)})
+					return match;
+			}
+			return std::nullopt;
+		}
+
+	#if defined(__x86_64__) || defined(__i386__)
+		/*
+		 * Shufti-style scanner: each byte is split into its two nibbles, which are looked up in the
+		 * nibble tables of the set. A byte can only be part of the set if both lookups share a bucket.
+		 * Bytes outside of ASCII are flagged by their sign bit and confirmed by `matchAt`.
+		 * */
+		[[gnu::target("ssse3")]]
+		auto findAnyOfSsse3(const std::u8string_view string, const core::CharSet& pattern) noexcept
+			-> std::optional<std::pair<std::size_t, std::size_t>>
+		{
+			const __m128i lowNibbles {_mm_loadu_si128(reinterpret_cast<const __m128i*> (pattern.getLowNibbles().data()))};
+			const __m128i highNibbles {_mm_loadu_si128(reinterpret_cast<const __m128i*> (pattern.getHighNibbles().data()))};
+			const __m128i nibbleMask {_mm_set1_epi8(0x0f)};
+			const int nonAsciiMask {pattern.hasNonAscii() ? 0xffff : 0};
+
+			std::size_t index {0uz};
+			for (; index + 16uz <= string.size(); index += 16uz) {
+				const __m128i block {_mm_loadu_si128(reinterpret_cast<const __m128i*> (string.data() + index))};
+				const __m128i low {_mm_shuffle_epi8(lowNibbles, _mm_and_si128(block, nibbleMask))};
+				const __m128i high {_mm_shuffle_epi8(highNibbles, _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask))};
+				const __m128i isNotCandidate {_mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128())};
+				unsigned int candidates {static_cast<unsigned int> (
+					(~_mm_movemask_epi8(isNotCandidate) & 0xffff) | (_mm_movemask_epi8(block) & nonAsciiMask)
+				)};
+				while (candidates != 0) {
+					const std::size_t candidate {index + static_cast<std::size_t> (std::countr_zero(candidates))};
+					if (const auto match {matchAt(string, candidate, pattern)})
+						return match;
+					candidates &= candidates - 1;
+				}
+			}
+			return findAnyOfScalar(string, index, pattern);
+		}
+	#endif
+	}
+
+
+	auto startWithAnyOf(const std::u8string_view string, const core::CharSet& pattern) noexcept
+		-> std::optional<std::u8string_view>
+	{
+		assert(!string.empty());
+		const auto match {matchAt(string, 0uz, pattern)};
+		if (!match)
+			return std::nullopt;
+		return string.substr(match->second);
+	}
+
 	auto startWithAnyOf(const std::u8string_view string, const std::u32string_view pattern) noexcept
 		-> std::optional<std::u8string_view>
 	{
 		const std::optional utf32WithAdvance {iterativeUtf8ToUtf32(string)};
 		assert(utf32WithAdvance);
 		auto [utf32, newString] {*utf32WithAdvance};
-		for (const auto patternUtf32 : pattern) {
-			if (utf32 == patternUtf32)
-				return newString;
-		}
+		if (pattern.contains(utf32))
+			return newString;
 		return std::nullopt;
 	}
 
+	auto findAnyOf(const std::u8string_view string, const core::CharSet& pattern) noexcept
+		-> std::optional<std::pair<std::size_t, std::size_t>>
+	{
+	#if defined(__x86_64__) || defined(__i386__)
+		static const bool hasSsse3 {__builtin_cpu_supports("ssse3") != 0};
+		if (hasSsse3)
+			return findAnyOfSsse3(string, pattern);
+	#endif
+		return findAnyOfScalar(string, 0uz, pattern);
+	}
+
 	auto findAnyOf(const std::u8string_view string, const std::u8string_view pattern) noexcept
 		-> std::optional<std::pair<std::size_t, std::size_t>>
 	{
-		for (const auto& [index, size, utf32] : string | core::enumerate_utf32_converter_view) {
-			for (const auto patternUtf32 : pattern | core::utf32_converter_view) {
-				if (utf32 != patternUtf32)
-					continue;
-				return std::make_pair(index, size);
+		core::CharSet charSet {};
+		for (const auto patternUtf32 : pattern | core::utf32_converter_view) {
+			if (!charSet.insert(patternUtf32)) {
+				std::u32string utf32Pattern {};
+				for (const auto utf32 : pattern | core::utf32_converter_view)
+					utf32Pattern.push_back(utf32);
+				return findAnyOfLinear(string, utf32Pattern);
 			}
 		}
-		return std::nullopt;
+		return core::findAnyOf(string, charSet);
 	}
 
 	auto findAnyOf(const std::u8string_view string, const std::u32string_view pattern) noexcept
 		-> std::optional<std::pair<std::size_t, std::size_t>>
 	{
-		for (const auto& [index, size, utf32] : string | core::enumerate_utf32_converter_view) {
-			for (const auto patternUtf32 : pattern) {
-				if (utf32 != patternUtf32)
-					continue;
-				return std::make_pair(index, size);
-			}
+		core::CharSet charSet {};
+		for (const auto patternUtf32 : pattern) {
+			if (!charSet.insert(patternUtf32))
+				return findAnyOfLinear(string, pattern);
 		}
-		return std::nullopt;
+		return core::findAnyOf(string, charSet);
 	}
 }
@@ -0,0 +1,50 @@
+#include "volt/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stop_token>
+
+
+namespace volt::core {
+	ThreadPool::ThreadPool(const std::size_t threadCount) noexcept :
+		m_mutex {},
+		m_condition {},
+		m_jobs {},
+		m_threads {}
+	{
+		m_threads.reserve(std::max(threadCount, 1uz));
+		for (std::size_t i {0uz}; i < std::max(threadCount, 1uz); ++i)
+			m_threads.emplace_back([this] (std::stop_token stopToken) noexcept {this->work(stopToken);});
+	}
+
+	ThreadPool::~ThreadPool() {
+		for (auto& thread : m_threads)
+			thread.request_stop();
+		m_condition.notify_all();
+		m_threads.clear();
+	}
+
+	auto ThreadPool::push(std::move_only_function<void()>&& job) noexcept -> void {
+		{
+			std::scoped_lock _ {m_mutex};
+			m_jobs.push(std::move(job));
+		}
+		m_condition.notify_one();
+	}
+
+	auto ThreadPool::work(std::stop_token stopToken) noexcept -> void {
+		while (true) {
+			std::move_only_function<void()> job {};
+			{
+				std::unique_lock lock {m_mutex};
+				// the remaining jobs are still run once a stop is requested
+				m_condition.wait(lock, stopToken, [this] {return !m_jobs.empty();});
+				if (m_jobs.empty())
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop();
+			}
+			job();
+		}
+	}
+}
@@ -0,0 +1,160 @@
+#include "volt/core/type_registry.hpp"
+
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+
+namespace volt::core {
+	namespace {
+		constexpr std::size_t FIRST_TABLE_CAPACITY {64uz};
+
+		auto getSegmentIndex(const std::size_t UUID, const std::size_t firstSegmentSize) noexcept
+			-> std::pair<std::size_t, std::size_t>
+		{
+			const std::size_t segment {static_cast<std::size_t> (std::bit_width(UUID / firstSegmentSize + 1uz)) - 1uz};
+			const std::size_t segmentStart {firstSegmentSize * ((1uz << segment) - 1uz)};
+			return std::make_pair(segment, UUID - segmentStart);
+		}
+	}
+
+
+	TypeRegistry::TypeRegistry() noexcept :
+		m_shards {},
+		m_segments {},
+		m_count {0uz},
+		m_publishedCount {0uz}
+	{
+		for (auto& shard : m_shards) {
+			auto& table {shard.tables.emplace_back(std::make_unique<Table> (Table{
+				.capacity = FIRST_TABLE_CAPACITY,
+				.count = 0uz,
+				.slots = std::make_unique<std::atomic<const core::TypeDescriptor*>[]> (FIRST_TABLE_CAPACITY)
+			}))};
+			shard.table.store(table.get(), std::memory_order_release);
+		}
+	}
+
+	TypeRegistry::~TypeRegistry() {
+		const std::size_t count {m_count.load(std::memory_order_acquire)};
+		for (std::size_t UUID {0uz}; UUID < count; ++UUID)
+			delete this->getSlot(UUID).load(std::memory_order_acquire);
+		for (auto& segment : m_segments)
+			delete[] segment.load(std::memory_order_acquire);
+	}
+
+	auto TypeRegistry::intern(const std::u8string_view identifier) noexcept -> const core::TypeDescriptor& {
+		const std::size_t hash {std::hash<std::u8string_view> {} (identifier)};
+		Shard& shard {m_shards[hash % SHARD_COUNT]};
+		if (const auto* descriptor {findInTable(*shard.table.load(std::memory_order_acquire), identifier, hash)})
+			return *descriptor;
+
+		std::scoped_lock _ {shard.insertMutex};
+		Table* table {shard.table.load(std::memory_order_relaxed)};
+		if (const auto* descriptor {findInTable(*table, identifier, hash)})
+			return *descriptor;
+
+		// readers may still use the old table, so it is kept alive until the registry is destroyed
+		if ((table->count + 1uz) * 2uz > table->capacity) {
+			auto& newTable {shard.tables.emplace_back(std::make_unique<Table> (Table{
+				.capacity = table->capacity * 2uz,
+				.count = 0uz,
+				.slots = std::make_unique<std::atomic<const core::TypeDescriptor*>[]> (table->capacity * 2uz)
+			}))};
+			for (std::size_t i {0uz}; i < table->capacity; ++i) {
+				const auto* descriptor {table->slots[i].load(std::memory_order_relaxed)};
+				if (descriptor != nullptr)
+					insertInTable(*newTable, *descriptor, std::hash<std::u8string_view> {} (descriptor->identifier));
+			}
+			table = newTable.get();
+			shard.table.store(table, std::memory_order_release);
+		}
+
+		const std::size_t UUID {m_count.fetch_add(1uz, std::memory_order_acq_rel)};
+		const auto* descriptor {new core::TypeDescriptor{.UUID = UUID, .identifier = std::u8string{identifier}}};
+		this->getSlot(UUID).store(descriptor, std::memory_order_seq_cst);
+		insertInTable(*table, *descriptor, hash);
+		this->publish();
+		return *descriptor;
+	}
+
+	auto TypeRegistry::find(const std::u8string_view identifier) const noexcept -> const core::TypeDescriptor* {
+		const std::size_t hash {std::hash<std::u8string_view> {} (identifier)};
+		const Shard& shard {m_shards[hash % SHARD_COUNT]};
+		return findInTable(*shard.table.load(std::memory_order_acquire), identifier, hash);
+	}
+
+	auto TypeRegistry::get(const std::size_t UUID) const noexcept -> const core::TypeDescriptor* {
+		// a filled slot never changes, so it doesn't have to wait for the smaller UUIDs to be published
+		if (UUID >= m_count.load(std::memory_order_acquire))
+			return nullptr;
+		return this->loadSlot(UUID);
+	}
+
+	auto TypeRegistry::getTypes() const noexcept -> std::generator<const core::TypeDescriptor&> {
+		// published types never have a gap before them, so every snapshot is a prefix of the next ones
+		const std::size_t count {m_publishedCount.load(std::memory_order_acquire)};
+		for (std::size_t UUID {0uz}; UUID < count; ++UUID)
+			co_yield *this->loadSlot(UUID);
+	}
+
+	auto TypeRegistry::publish() noexcept -> void {
+		/*
+		 * The thread filling the first empty slot publishes every filled slot after it, including the
+		 * ones of other threads. Sequential consistency makes sure that when two threads race, one of
+		 * them sees the slot of the other one.
+		 * */
+		std::size_t published {m_publishedCount.load(std::memory_order_seq_cst)};
+		while (published < m_count.load(std::memory_order_seq_cst) && this->loadSlot(published) != nullptr) {
+			if (m_publishedCount.compare_exchange_weak(published, published + 1uz, std::memory_order_seq_cst))
+				++published;
+		}
+	}
+
+	auto TypeRegistry::loadSlot(const std::size_t UUID) const noexcept -> const core::TypeDescriptor* {
+		const auto [segmentIndex, offset] {getSegmentIndex(UUID, FIRST_SEGMENT_SIZE)};
+		const auto* segment {m_segments[segmentIndex].load(std::memory_order_acquire)};
+		if (segment == nullptr)
+			return nullptr;
+		return segment[offset].load(std::memory_order_seq_cst);
+	}
+
+	auto TypeRegistry::findInTable(const Table& table, const std::u8string_view identifier, const std::size_t hash) noexcept
+		-> const core::TypeDescriptor*
+	{
+		const std::size_t mask {table.capacity - 1uz};
+		for (std::size_t i {(hash / SHARD_COUNT) & mask};; i = (i + 1uz) & mask) {
+			const auto* descriptor {table.slots[i].load(std::memory_order_acquire)};
+			if (descriptor == nullptr || descriptor->identifier == identifier)
+				return descriptor;
+		}
+	}
+
+	auto TypeRegistry::insertInTable(Table& table, const core::TypeDescriptor& descriptor, const std::size_t hash) noexcept
+		-> void
+	{
+		assert((table.count + 1uz) * 2uz <= table.capacity);
+		const std::size_t mask {table.capacity - 1uz};
+		std::size_t i {(hash / SHARD_COUNT) & mask};
+		while (table.slots[i].load(std::memory_order_relaxed) != nullptr)
+			i = (i + 1uz) & mask;
+		table.slots[i].store(&descriptor, std::memory_order_release);
+		++table.count;
+	}
+
+	auto TypeRegistry::getSlot(const std::size_t UUID) noexcept -> std::atomic<const core::TypeDescriptor*>& {
+		const auto [segmentIndex, offset] {getSegmentIndex(UUID, FIRST_SEGMENT_SIZE)};
+		auto& segment {m_segments[segmentIndex]};
+		auto* slots {segment.load(std::memory_order_acquire)};
+		if (slots == nullptr) {
+			auto* newSlots {new std::atomic<const core::TypeDescriptor*>[FIRST_SEGMENT_SIZE << segmentIndex] {}};
+			if (segment.compare_exchange_strong(slots, newSlots, std::memory_order_acq_rel))
+				slots = newSlots;
+			else
+				delete[] newSlots;
+		}
+		return slots[offset];
+	}
+}
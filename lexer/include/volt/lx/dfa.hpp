@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace volt::lx {
+	/**
+	 * @brief The states of the lexer DFA
+	 *
+	 * Only the states referenced by the grammar are named. The states of the operators are generated
+	 * by `lx::buildRawDfa` and are numbered right after `eFixedStateCount`. The two last values are
+	 * markers stored in the transition table instead of a state.
+	 * */
+	enum class DfaState : std::uint8_t {
+		eStart,
+		eEOL,
+		eEOS,
+		eIdentifier,
+		eNumber,
+		eNumberExponent,
+		eNumberExponentSign,
+		eStringLiteral,
+		eStringLiteralEscape,
+		eStringLiteralEnd,
+		eCharacterLiteral,
+		eCharacterLiteralEscape,
+		eCharacterLiteralEnd,
+		eSingleLineComment,
+		eMultilineComment,
+		eMultilineCommentStar,
+		eMultilineCommentEnd,
+
+		eFixedStateCount,
+
+		//! the transition depends on the whole code point, which must be decoded
+		eUnicode = 0xfe,
+		//! no transition, the current token is finished
+		eReject = 0xff,
+	};
+
+	//! what the lexer does with the text matched when a DFA state is left
+	enum class DfaAction : std::uint8_t {
+		eNone,
+		eEOL,
+		eEOS,
+		eIdentifier,
+		eOperator,
+		eNumber,
+		eStringLiteral,
+		eCharacterLiteral,
+		eSingleLineComment,
+		eMultilineComment,
+	};
+}
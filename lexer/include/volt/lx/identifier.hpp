@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "volt/lx/export.hpp"
+
+
+namespace volt::lx {
+	/**
+	 * @brief A handle to an identifier interned in a `lx::IdentifierTable`
+	 *
+	 * Identifiers are NFC-normalized when interned, so two identifiers compare equal iff they are
+	 * canonically equivalent. Comparison and hashing are O(1).
+	 * */
+	class Identifier final {
+		friend class IdentifierTable;
+
+		public:
+			constexpr Identifier() noexcept = default;
+			constexpr ~Identifier() = default;
+
+			constexpr auto operator==(const Identifier&) const noexcept -> bool = default;
+
+			inline auto getText() const noexcept -> std::u8string_view {
+				return m_entry->text;
+			}
+			inline auto getHash() const noexcept -> std::size_t {
+				return m_entry->hash;
+			}
+
+		private:
+			struct Entry {
+				std::u8string text;
+				std::size_t hash;
+			};
+
+			constexpr Identifier(const Entry* entry) noexcept : m_entry {entry} {}
+
+			const Entry* m_entry {nullptr};
+	};
+
+	class IdentifierTable final {
+		public:
+			IdentifierTable(const IdentifierTable&) = delete;
+			auto operator=(const IdentifierTable&) -> IdentifierTable& = delete;
+			IdentifierTable(IdentifierTable&&) = delete;
+			auto operator=(IdentifierTable&&) -> IdentifierTable& = delete;
+
+			inline IdentifierTable() noexcept = default;
+			inline ~IdentifierTable() = default;
+
+			VOLT_LX_EXPORT auto intern(std::u8string_view identifier) noexcept -> lx::Identifier;
+
+			inline auto getCount() const noexcept -> std::size_t {
+				return m_entries.size();
+			}
+
+		private:
+			auto internNormalized(std::u8string_view identifier) noexcept -> lx::Identifier;
+
+			std::unordered_map<std::u8string_view, std::unique_ptr<lx::Identifier::Entry>> m_entries;
+	};
+}
+
+template <>
+struct std::hash<volt::lx::Identifier> {
+	inline auto operator()(const volt::lx::Identifier& identifier) const noexcept -> std::size_t {
+		return identifier.getHash();
+	}
+};
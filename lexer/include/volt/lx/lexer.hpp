@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <generator>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
+#include "volt/core/arena.hpp"
+#include "volt/lx/dfa.hpp"
 #include "volt/lx/export.hpp"
 #include "volt/lx/token.hpp"
 
@@ -17,5 +23,76 @@ namespace volt::lx {
 	VOLT_LX_EXPORT auto isNumerLiteralCharacters(char32_t character) noexcept -> bool;
 	VOLT_LX_EXPORT auto isNumerLiteralStartCharacters(char32_t character) noexcept -> bool;
 
-	VOLT_LX_EXPORT auto lex(std::u8string_view rawData) noexcept -> std::generator<lx::Token>;
+	enum class CommentMode {
+		//! comments are emitted as `eOpenComment` / `eSingleLineComment`, `eCommentContent` and `eCloseComment` tokens
+		eEmit,
+		//! comments are dropped
+		eSkip,
+		//! comments are dropped from the token stream, but recorded in `LexerOptions::commentTable`
+		eRecord,
+	};
+
+	struct Comment {
+		//! offset of the content of the comment from the start of the input, in bytes
+		std::size_t offset;
+		std::size_t size;
+		bool isMultiline;
+	};
+
+	struct LexerOptions {
+		lx::CommentMode comments {lx::CommentMode::eEmit};
+		std::vector<lx::Comment>* commentTable {nullptr};
+		//! if set, string and character literals are yielded decoded and stored in this arena, see `lx::decodeLiteral`
+		core::Arena* literalArena {nullptr};
+	};
+
+	/**
+	 * @brief A resumable lexer that accepts its input in arbitrary chunks
+	 *
+	 * Chunks may split a token or an UTF-8 sequence. Only the unfinished tail of the input is kept
+	 * between two calls, so the memory used is bounded by the longest token.
+	 * The metadata of the yielded tokens may point inside the lexer or inside the given chunk, and
+	 * thus is only valid until the next call to `feed` or `finish`. Literals decoded into the literal
+	 * arena of the options live as long as the arena.
+	 * */
+	class Lexer final {
+		public:
+			Lexer(const Lexer&) = delete;
+			auto operator=(const Lexer&) -> Lexer& = delete;
+			Lexer(Lexer&&) = delete;
+			auto operator=(Lexer&&) -> Lexer& = delete;
+
+			constexpr Lexer(const lx::LexerOptions& options = {}) noexcept : m_options {options} {}
+			constexpr ~Lexer() = default;
+
+			VOLT_LX_EXPORT auto feed(std::u8string_view chunk) noexcept -> std::generator<lx::Token>;
+			VOLT_LX_EXPORT auto finish(std::u8string_view chunk = {}) noexcept -> std::generator<lx::Token>;
+
+		private:
+			auto lexWindow(std::u8string_view window, bool isLastWindow) noexcept -> std::generator<lx::Token>;
+			auto skipTokenContent(std::u8string_view rawData, std::size_t index) noexcept -> std::size_t;
+			auto dropComment(lx::DfaAction action, std::size_t index) noexcept -> bool;
+
+			lx::LexerOptions m_options;
+			lx::DfaState m_state {lx::DfaState::eStart};
+			std::size_t m_tokenIndex {0uz};
+			std::size_t m_resumeIndex {0uz};
+			//! offset of the start of the window from the start of the input
+			std::size_t m_windowOffset {0uz};
+			//! offset of the start of a dropped comment whose text isn't kept between two windows
+			std::optional<std::size_t> m_commentOffset {};
+			std::u8string m_pending {};
+	};
+
+	VOLT_LX_EXPORT auto lex(std::u8string_view rawData, lx::LexerOptions options = {}) noexcept
+		-> std::generator<lx::Token>;
+	/**
+	 * @brief Lex on a background thread, overlapping lexing with the consumer of the tokens
+	 *
+	 * The tokens are handed to the calling thread in fixed-size blocks through a bounded queue, so
+	 * the lexer can't get arbitrarily ahead of the consumer. The comment table of `options` is filled
+	 * by the background thread, and must only be read once all the tokens have been consumed.
+	 * */
+	VOLT_LX_EXPORT auto lexPipelined(std::u8string_view rawData, lx::LexerOptions options = {}) noexcept
+		-> std::generator<lx::Token>;
 }
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+#include "volt/core/arena.hpp"
+#include "volt/lx/export.hpp"
+
+
+namespace volt::lx {
+	/**
+	 * @brief Decode the escape sequences of the content of a string or character literal
+	 *
+	 * Supported escapes are `\n`, `\t`, `\r`, `\0`, `\\`, `\'`, `\"`, `\xHH` and `\u{H...}`.
+	 * Unknown or malformed escapes are kept as is. The cooked bytes are written once into `arena`,
+	 * and the returned view lives as long as it.
+	 * */
+	VOLT_LX_EXPORT auto decodeLiteral(std::u8string_view content, core::Arena& arena) noexcept -> std::u8string_view;
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "volt/lx/dfa.hpp"
+
+
+/*
+ * The grammar of the lexer and the DFA built from it at compile time. Only the lexer includes it,
+ * so that the table is built once instead of in every user of `volt/lx/lexer.hpp`.
+ * */
+namespace volt::lx {
+	struct DfaByteSet {
+		std::array<bool, 256uz> bytes;
+
+		constexpr auto operator|(const DfaByteSet& other) const noexcept -> DfaByteSet {
+			DfaByteSet result {*this};
+			for (std::size_t i {0uz}; i < bytes.size(); ++i)
+				result.bytes[i] = result.bytes[i] || other.bytes[i];
+			return result;
+		}
+	};
+
+	constexpr auto makeDfaByteSet(const std::u8string_view bytes) noexcept -> lx::DfaByteSet {
+		lx::DfaByteSet result {};
+		for (const char8_t byte : bytes)
+			result.bytes[byte] = true;
+		return result;
+	}
+
+	constexpr auto makeDfaByteSet(const std::size_t first, const std::size_t last) noexcept -> lx::DfaByteSet {
+		lx::DfaByteSet result {};
+		for (std::size_t byte {first}; byte <= last; ++byte)
+			result.bytes[byte] = true;
+		return result;
+	}
+
+
+	struct DfaRule {
+		lx::DfaState from;
+		lx::DfaByteSet bytes;
+		lx::DfaState to;
+	};
+	struct DfaOperatorRule {
+		std::u8string_view from;
+		lx::DfaByteSet bytes;
+		lx::DfaState to;
+	};
+	struct DfaStateAction {
+		lx::DfaState state;
+		lx::DfaAction action;
+	};
+
+
+	namespace dfa_bytes {
+		constexpr lx::DfaByteSet any {lx::makeDfaByteSet(0x00uz, 0xffuz)};
+		constexpr lx::DfaByteSet nonAscii {lx::makeDfaByteSet(0x80uz, 0xffuz)};
+		constexpr lx::DfaByteSet digits {lx::makeDfaByteSet(u8"0123456789")};
+		constexpr lx::DfaByteSet identifierStart {
+			lx::makeDfaByteSet(u8'a', u8'z') | lx::makeDfaByteSet(u8'A', u8'Z') | lx::makeDfaByteSet(u8"_")
+		};
+		constexpr lx::DfaByteSet identifier {identifierStart | digits};
+		constexpr lx::DfaByteSet spaces {lx::makeDfaByteSet(u8" \t\r\v\f")};
+	}
+
+	/*
+	 * The token grammar of the lexer. Operators only need to be listed here, their states are
+	 * generated. Every prefix of an operator must be an operator itself.
+	 * */
+	constexpr auto lexerOperators = std::to_array<std::u8string_view> ({
+		u8"=", u8"<", u8">", u8"+", u8"-", u8"*", u8"/", u8"%", u8"&", u8"|",
+		u8"(", u8")", u8"[", u8"]", u8"{", u8"}", u8",", u8".", u8"?", u8":", u8"~", u8"^", u8"!",
+		u8"==", u8"!=", u8"<=", u8">=", u8"<<", u8">>", u8"<<=", u8">>=",
+		u8"+=", u8"-=", u8"*=", u8"/=", u8"%=", u8"&=", u8"|=", u8"^=",
+		u8"&&", u8"||", u8"->",
+	});
+
+	constexpr auto lexerRules = std::to_array<lx::DfaRule> ({
+		{lx::DfaState::eStart, lx::dfa_bytes::spaces,               lx::DfaState::eStart},
+		{lx::DfaState::eStart, lx::makeDfaByteSet(u8"\n"),          lx::DfaState::eEOL},
+		{lx::DfaState::eStart, lx::makeDfaByteSet(u8";"),           lx::DfaState::eEOS},
+		{lx::DfaState::eStart, lx::dfa_bytes::identifierStart,      lx::DfaState::eIdentifier},
+		{lx::DfaState::eStart, lx::dfa_bytes::nonAscii,             lx::DfaState::eUnicode},
+		{lx::DfaState::eStart, lx::dfa_bytes::digits,               lx::DfaState::eNumber},
+		{lx::DfaState::eStart, lx::makeDfaByteSet(u8"\""),          lx::DfaState::eStringLiteral},
+		{lx::DfaState::eStart, lx::makeDfaByteSet(u8"'"),           lx::DfaState::eCharacterLiteral},
+
+		{lx::DfaState::eIdentifier, lx::dfa_bytes::identifier,      lx::DfaState::eIdentifier},
+		{lx::DfaState::eIdentifier, lx::dfa_bytes::nonAscii,        lx::DfaState::eUnicode},
+
+		{lx::DfaState::eNumber, lx::dfa_bytes::digits | lx::makeDfaByteSet(u8"_"), lx::DfaState::eNumber},
+		{lx::DfaState::eNumber, lx::makeDfaByteSet(u8"e"),          lx::DfaState::eNumberExponent},
+		{lx::DfaState::eNumberExponent, lx::makeDfaByteSet(u8"+-"), lx::DfaState::eNumberExponentSign},
+		{lx::DfaState::eNumberExponent, lx::dfa_bytes::digits,      lx::DfaState::eNumber},
+		{lx::DfaState::eNumberExponentSign, lx::dfa_bytes::digits,  lx::DfaState::eNumber},
+
+		{lx::DfaState::eStringLiteral, lx::dfa_bytes::any,          lx::DfaState::eStringLiteral},
+		{lx::DfaState::eStringLiteral, lx::makeDfaByteSet(u8"\\"),  lx::DfaState::eStringLiteralEscape},
+		{lx::DfaState::eStringLiteral, lx::makeDfaByteSet(u8"\""),  lx::DfaState::eStringLiteralEnd},
+		{lx::DfaState::eStringLiteralEscape, lx::dfa_bytes::any,    lx::DfaState::eStringLiteral},
+
+		{lx::DfaState::eCharacterLiteral, lx::dfa_bytes::any,       lx::DfaState::eCharacterLiteral},
+		{lx::DfaState::eCharacterLiteral, lx::makeDfaByteSet(u8"\\"), lx::DfaState::eCharacterLiteralEscape},
+		{lx::DfaState::eCharacterLiteral, lx::makeDfaByteSet(u8"'"), lx::DfaState::eCharacterLiteralEnd},
+		{lx::DfaState::eCharacterLiteralEscape, lx::dfa_bytes::any, lx::DfaState::eCharacterLiteral},
+
+		{lx::DfaState::eSingleLineComment, lx::dfa_bytes::any,      lx::DfaState::eSingleLineComment},
+		{lx::DfaState::eSingleLineComment, lx::makeDfaByteSet(u8"\n"), lx::DfaState::eReject},
+
+		{lx::DfaState::eMultilineComment, lx::dfa_bytes::any,       lx::DfaState::eMultilineComment},
+		{lx::DfaState::eMultilineComment, lx::makeDfaByteSet(u8"*"), lx::DfaState::eMultilineCommentStar},
+		{lx::DfaState::eMultilineCommentStar, lx::dfa_bytes::any,   lx::DfaState::eMultilineComment},
+		{lx::DfaState::eMultilineCommentStar, lx::makeDfaByteSet(u8"*"), lx::DfaState::eMultilineCommentStar},
+		{lx::DfaState::eMultilineCommentStar, lx::makeDfaByteSet(u8"/"), lx::DfaState::eMultilineCommentEnd},
+	});
+
+	constexpr auto lexerOperatorRules = std::to_array<lx::DfaOperatorRule> ({
+		{u8"+", lx::dfa_bytes::digits,         lx::DfaState::eNumber},
+		{u8"-", lx::dfa_bytes::digits,         lx::DfaState::eNumber},
+		{u8"/", lx::makeDfaByteSet(u8"/"),     lx::DfaState::eSingleLineComment},
+		{u8"/", lx::makeDfaByteSet(u8"*"),     lx::DfaState::eMultilineComment},
+	});
+
+	constexpr auto lexerStateActions = std::to_array<lx::DfaStateAction> ({
+		{lx::DfaState::eEOL,                  lx::DfaAction::eEOL},
+		{lx::DfaState::eEOS,                  lx::DfaAction::eEOS},
+		{lx::DfaState::eIdentifier,           lx::DfaAction::eIdentifier},
+		{lx::DfaState::eNumber,               lx::DfaAction::eNumber},
+		{lx::DfaState::eNumberExponent,       lx::DfaAction::eNumber},
+		{lx::DfaState::eNumberExponentSign,   lx::DfaAction::eNumber},
+		{lx::DfaState::eStringLiteralEnd,     lx::DfaAction::eStringLiteral},
+		{lx::DfaState::eCharacterLiteralEnd,  lx::DfaAction::eCharacterLiteral},
+		{lx::DfaState::eSingleLineComment,    lx::DfaAction::eSingleLineComment},
+		{lx::DfaState::eMultilineCommentEnd,  lx::DfaAction::eMultilineComment},
+	});
+
+
+	struct RawDfa {
+		static constexpr std::size_t MAX_STATE_COUNT {static_cast<std::size_t> (lx::DfaState::eUnicode)};
+
+		std::size_t stateCount;
+		std::array<std::array<lx::DfaState, 256uz>, MAX_STATE_COUNT> transitions;
+		std::array<lx::DfaAction, MAX_STATE_COUNT> actions;
+	};
+
+	/**
+	 * @brief A DFA whose transition table is indexed by byte classes
+	 *
+	 * Bytes that behave the same way in every state share the same class, which keeps the
+	 * transition table small enough to stay in L1.
+	 * */
+	template <std::size_t StateCount, std::size_t ClassCount>
+	struct Dfa {
+		std::array<std::uint8_t, 256uz> classes;
+		std::array<lx::DfaState, StateCount * ClassCount> transitions;
+		std::array<lx::DfaAction, StateCount> actions;
+
+		constexpr auto next(const lx::DfaState state, const char8_t byte) const noexcept -> lx::DfaState {
+			return transitions[static_cast<std::size_t> (state) * ClassCount + classes[byte]];
+		}
+		constexpr auto action(const lx::DfaState state) const noexcept -> lx::DfaAction {
+			return actions[static_cast<std::size_t> (state)];
+		}
+	};
+
+
+	consteval auto buildRawDfa(
+		const std::span<const std::u8string_view> operators,
+		const std::span<const lx::DfaRule> rules,
+		const std::span<const lx::DfaOperatorRule> operatorRules,
+		const std::span<const lx::DfaStateAction> stateActions
+	) -> lx::RawDfa {
+		lx::RawDfa dfa {};
+		dfa.stateCount = static_cast<std::size_t> (lx::DfaState::eFixedStateCount);
+		for (auto& transitions : dfa.transitions)
+			transitions.fill(lx::DfaState::eReject);
+		for (const auto& [state, action] : stateActions)
+			dfa.actions[static_cast<std::size_t> (state)] = action;
+
+		const auto findOperatorState {[&dfa] (const std::u8string_view operator_) {
+			lx::DfaState state {lx::DfaState::eStart};
+			for (const char8_t byte : operator_)
+				state = dfa.transitions[static_cast<std::size_t> (state)][byte];
+			return state;
+		}};
+
+		for (const auto operator_ : operators) {
+			lx::DfaState state {lx::DfaState::eStart};
+			for (const char8_t byte : operator_) {
+				auto& next {dfa.transitions[static_cast<std::size_t> (state)][byte]};
+				if (next == lx::DfaState::eReject) {
+					if (dfa.stateCount == lx::RawDfa::MAX_STATE_COUNT)
+						throw "Too many states in the lexer DFA";
+					next = static_cast<lx::DfaState> (dfa.stateCount++);
+				}
+				state = next;
+			}
+			dfa.actions[static_cast<std::size_t> (state)] = lx::DfaAction::eOperator;
+		}
+		for (const auto operator_ : operators) {
+			for (std::size_t i {1uz}; i < operator_.size(); ++i) {
+				if (dfa.actions[static_cast<std::size_t> (findOperatorState(operator_.substr(0uz, i)))] != lx::DfaAction::eOperator)
+					throw "Every prefix of an operator must be an operator";
+			}
+		}
+
+		const auto applyRule {[&dfa] (const lx::DfaState from, const lx::DfaByteSet& bytes, const lx::DfaState to) {
+			for (std::size_t byte {0uz}; byte < bytes.bytes.size(); ++byte) {
+				if (bytes.bytes[byte])
+					dfa.transitions[static_cast<std::size_t> (from)][byte] = to;
+			}
+		}};
+		for (const auto& [from, bytes, to] : rules)
+			applyRule(from, bytes, to);
+		for (const auto& [from, bytes, to] : operatorRules)
+			applyRule(findOperatorState(from), bytes, to);
+		return dfa;
+	}
+
+	consteval auto countDfaByteClasses(const lx::RawDfa& dfa) -> std::size_t {
+		std::size_t classCount {0uz};
+		for (std::size_t byte {0uz}; byte < 256uz; ++byte) {
+			bool isNewClass {true};
+			for (std::size_t other {0uz}; other < byte && isNewClass; ++other) {
+				bool isSameClass {true};
+				for (std::size_t state {0uz}; state < dfa.stateCount && isSameClass; ++state)
+					isSameClass = dfa.transitions[state][byte] == dfa.transitions[state][other];
+				isNewClass = !isSameClass;
+			}
+			if (isNewClass)
+				++classCount;
+		}
+		return classCount;
+	}
+
+	template <std::size_t StateCount, std::size_t ClassCount>
+	consteval auto compressRawDfa(const lx::RawDfa& dfa) -> lx::Dfa<StateCount, ClassCount> {
+		lx::Dfa<StateCount, ClassCount> result {};
+		std::array<std::size_t, ClassCount> classRepresentatives {};
+		std::size_t classCount {0uz};
+		for (std::size_t byte {0uz}; byte < 256uz; ++byte) {
+			std::size_t byteClass {0uz};
+			for (; byteClass < classCount; ++byteClass) {
+				bool isSameClass {true};
+				for (std::size_t state {0uz}; state < StateCount && isSameClass; ++state)
+					isSameClass = dfa.transitions[state][byte] == dfa.transitions[state][classRepresentatives[byteClass]];
+				if (isSameClass)
+					break;
+			}
+			if (byteClass == classCount)
+				classRepresentatives[classCount++] = byte;
+			result.classes[byte] = static_cast<std::uint8_t> (byteClass);
+		}
+
+		for (std::size_t state {0uz}; state < StateCount; ++state) {
+			for (std::size_t byteClass {0uz}; byteClass < ClassCount; ++byteClass)
+				result.transitions[state * ClassCount + byteClass] = dfa.transitions[state][classRepresentatives[byteClass]];
+			result.actions[state] = dfa.actions[state];
+		}
+		return result;
+	}
+
+
+	constexpr auto lexerDfa {[] {
+		constexpr lx::RawDfa rawDfa {lx::buildRawDfa(
+			lx::lexerOperators,
+			lx::lexerRules,
+			lx::lexerOperatorRules,
+			lx::lexerStateActions
+		)};
+		return lx::compressRawDfa<rawDfa.stateCount, lx::countDfaByteClasses(rawDfa)> (rawDfa);
+	} ()};
+}
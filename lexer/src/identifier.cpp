@@ -0,0 +1,40 @@
+#include "volt/lx/identifier.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <unicodelib.h>
+
+#include "volt/core/string.hpp"
+
+
+namespace volt::lx {
+	auto IdentifierTable::intern(const std::u8string_view identifier) noexcept -> lx::Identifier {
+		// ASCII text is always in NFC
+		if (core::isAscii(identifier)) [[likely]]
+			return this->internNormalized(identifier);
+
+		std::u32string utf32 {};
+		for (const char32_t character : identifier | core::utf32_converter_view)
+			utf32.push_back(character);
+		std::u8string normalized {};
+		for (const char32_t character : unicode::to_nfc(utf32))
+			normalized += core::utf32ToUtf8(character);
+		return this->internNormalized(normalized);
+	}
+
+	auto IdentifierTable::internNormalized(const std::u8string_view identifier) noexcept -> lx::Identifier {
+		const auto entry {m_entries.find(identifier)};
+		if (entry != m_entries.end())
+			return lx::Identifier{entry->second.get()};
+
+		auto newEntry {std::make_unique<lx::Identifier::Entry> (lx::Identifier::Entry{
+			.text = std::u8string{identifier},
+			.hash = std::hash<std::u8string_view> {} (identifier)
+		})};
+		const lx::Identifier result {newEntry.get()};
+		m_entries.emplace(newEntry->text, std::move(newEntry));
+		return result;
+	}
+}
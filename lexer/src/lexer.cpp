@@ -1,19 +1,27 @@
 #include "volt/lx/lexer.hpp"
 
-#include <cassert>
+#include <algorithm>
+#include <array>
 #include <generator>
 #include <map>
-#include <numeric>
-#include <print>
+#include <memory>
+#include <optional>
 #include <ranges>
 #include <string_view>
+#include <thread>
+#include <utility>
 
 #include <unicodelib.h>
 
 #include "volt/core/janitor.hpp"
+#include "volt/core/spsc_queue.hpp"
 #include "volt/core/string.hpp"
+#include "volt/lx/dfa.hpp"
+#include "volt/lx/literal.hpp"
 #include "volt/lx/token.hpp"
 
+#include "dfa_tables.hpp"
+
 
 namespace volt::lx {
 	auto isIgnoredCharacters(char32_t character) noexcept -> bool {
@@ -44,230 +52,287 @@ namespace volt::lx {
 		return allowed.contains(character);
 	}
 
-	auto lex(const std::u8string_view rawData) noexcept -> std::generator<lx::Token> {
-		using namespace std::string_view_literals;
-		char32_t lastCharacter {U'\0'};
-		enum class ActiveMultichar {
-			eNone,
-			eIdentifier,
-			eSingleLineComment,
-			eMultilineComment,
-			eStartComment,
-			eNumberLiteral,
-			eStringLiteral,
-			eCharacterLiteral,
-		};
-		ActiveMultichar activeMultichar {ActiveMultichar::eNone};
-		struct TextData {
-			std::size_t index;
-			std::size_t size;
+	namespace {
+		auto makeIdentifierToken(const std::u8string_view identifier) noexcept -> lx::Token {
+			static const std::map<std::u8string_view, lx::TokenType> tokenTypeMap {
+				{u8"if",       lx::TokenType::eKeywordIf},
+				{u8"else",     lx::TokenType::eKeywordElse},
+				{u8"while",    lx::TokenType::eKeywordWhile},
+				{u8"for",      lx::TokenType::eKeywordFor},
+				{u8"loop",     lx::TokenType::eKeywordLoop},
+				{u8"continue", lx::TokenType::eKeywordContinue},
+				{u8"break",    lx::TokenType::eKeywordBreak},
+				{u8"func",     lx::TokenType::eKeywordFunc},
+				{u8"return",   lx::TokenType::eKeywordReturn},
+			};
+
+			const auto tokenType {tokenTypeMap.find(identifier)};
+			if (tokenType != tokenTypeMap.end()) return lx::Token{
+				.type = tokenType->second,
+				.metadata = {}
+			};
+			return lx::Token{
+				.type = lx::TokenType::eIdentifier,
+				.metadata = identifier,
+			};
+		}
+
+		struct TokenBatch {
+			std::array<lx::Token, 3uz> tokens;
+			std::size_t count;
 		};
-		TextData textData {};
 
-		for (const auto& [index, size, character] : rawData | core::enumerate_utf32_converter_view) {
-			core::Janitor _ {[&lastCharacter, character]() noexcept {lastCharacter = character;}};
-			if (activeMultichar == ActiveMultichar::eIdentifier) {
-				if (lx::isIdentifierCharacters(character)) {
-					textData.size += size;
-					continue;
-				}
-				static const std::map<std::u8string_view, lx::TokenType> tokenTypeMap {
-					{u8"if",       lx::TokenType::eKeywordIf},
-					{u8"else",     lx::TokenType::eKeywordElse},
-					{u8"while",    lx::TokenType::eKeywordWhile},
-					{u8"for",      lx::TokenType::eKeywordFor},
-					{u8"loop",     lx::TokenType::eKeywordLoop},
-					{u8"continue", lx::TokenType::eKeywordContinue},
-					{u8"break",    lx::TokenType::eKeywordBreak},
-					{u8"func",     lx::TokenType::eKeywordFunc},
-					{u8"return",   lx::TokenType::eKeywordReturn},
-				};
+		auto makeLiteralContent(const std::u8string_view text, core::Arena* literalArena) noexcept -> std::u8string_view {
+			const std::u8string_view content {text.substr(1uz, text.size() - 2uz)};
+			if (literalArena == nullptr)
+				return content;
+			return lx::decodeLiteral(content, *literalArena);
+		}
 
-				const std::u8string_view identifier {rawData.substr(textData.index, textData.size)};
-				const auto tokenType {tokenTypeMap.find(identifier)};
-				if (tokenType != tokenTypeMap.end()) co_yield lx::Token {
-					.type = tokenType->second,
-					.metadata = {}
-				};
-				else co_yield lx::Token{
-					.type = lx::TokenType::eIdentifier,
-					.metadata = identifier,
-				};
+		auto makeTokens(const lx::DfaAction action, const std::u8string_view text, core::Arena* literalArena) noexcept
+			-> TokenBatch
+		{
+			switch (action) {
+				case lx::DfaAction::eNone:
+					return {};
+				case lx::DfaAction::eEOL:
+					return {.tokens = {lx::Token{.type = lx::TokenType::eEOL, .metadata = {}}}, .count = 1uz};
+				case lx::DfaAction::eEOS:
+					return {.tokens = {lx::Token{.type = lx::TokenType::eEOS, .metadata = {}}}, .count = 1uz};
+				case lx::DfaAction::eIdentifier:
+					return {.tokens = {makeIdentifierToken(text)}, .count = 1uz};
+				case lx::DfaAction::eOperator:
+					return {.tokens = {lx::Token{.type = lx::TokenType::eOperator, .metadata = text}}, .count = 1uz};
+				case lx::DfaAction::eNumber:
+					return {.tokens = {lx::Token{.type = lx::TokenType::eLiteralNumber, .metadata = text}}, .count = 1uz};
+				case lx::DfaAction::eStringLiteral:
+					return {.tokens = {lx::Token{
+						.type = lx::TokenType::eLiteralString,
+						.metadata = makeLiteralContent(text, literalArena)
+					}}, .count = 1uz};
+				case lx::DfaAction::eCharacterLiteral:
+					return {.tokens = {lx::Token{
+						.type = lx::TokenType::eLiteralCharacter,
+						.metadata = makeLiteralContent(text, literalArena)
+					}}, .count = 1uz};
+				case lx::DfaAction::eSingleLineComment:
+					return {.tokens = {
+						lx::Token{.type = lx::TokenType::eSingleLineComment, .metadata = {}},
+						lx::Token{.type = lx::TokenType::eCommentContent, .metadata = text.substr(2uz)},
+					}, .count = 2uz};
+				case lx::DfaAction::eMultilineComment:
+					return {.tokens = {
+						lx::Token{.type = lx::TokenType::eOpenComment, .metadata = {}},
+						lx::Token{.type = lx::TokenType::eCommentContent, .metadata = text.substr(2uz, text.size() - 4uz)},
+						lx::Token{.type = lx::TokenType::eCloseComment, .metadata = {}},
+					}, .count = 3uz};
 			}
-			else if (activeMultichar == ActiveMultichar::eSingleLineComment) {
-				if (lx::isLineBreakCharacters(character)) {
-					co_yield lx::Token{
-						.type = lx::TokenType::eSingleLineComment,
-						.metadata = {}
-					};
-					co_yield lx::Token{
-						.type = lx::TokenType::eCommentContent,
-						.metadata = rawData.substr(textData.index, textData.size)
-					};
-				}
-				else if (index + size >= rawData.size()) {
-					co_yield lx::Token{
-						.type = lx::TokenType::eSingleLineComment,
-						.metadata = {}
-					};
-					co_yield lx::Token{
-						.type = lx::TokenType::eCommentContent,
-						.metadata = rawData.substr(textData.index, textData.size + size)
-					};
-					break;
-				}
-				else {
-					textData.size += size;
-					continue;
-				}
+			std::unreachable();
+		}
+
+		constexpr auto hasSkippableContent(const lx::DfaState state) noexcept -> bool {
+			return state == lx::DfaState::eStringLiteral
+				|| state == lx::DfaState::eCharacterLiteral
+				|| state == lx::DfaState::eSingleLineComment
+				|| state == lx::DfaState::eMultilineComment;
+		}
+	}
+
+
+	auto Lexer::feed(const std::u8string_view chunk) noexcept -> std::generator<lx::Token> {
+		if (m_pending.empty()) {
+			co_yield std::ranges::elements_of(this->lexWindow(chunk, false));
+			co_return;
+		}
+		m_pending += chunk;
+		co_yield std::ranges::elements_of(this->lexWindow(m_pending, false));
+	}
+
+	auto Lexer::finish(const std::u8string_view chunk) noexcept -> std::generator<lx::Token> {
+		if (m_pending.empty())
+			co_yield std::ranges::elements_of(this->lexWindow(chunk, true));
+		else {
+			m_pending += chunk;
+			co_yield std::ranges::elements_of(this->lexWindow(m_pending, true));
+		}
+
+		co_yield lx::Token{
+			.type = lx::TokenType::eEOF,
+			.metadata = {}
+		};
+		m_state = lx::DfaState::eStart;
+		m_tokenIndex = 0uz;
+		m_resumeIndex = 0uz;
+		m_windowOffset = 0uz;
+		m_commentOffset = std::nullopt;
+		m_pending.clear();
+	}
+
+	auto Lexer::skipTokenContent(const std::u8string_view rawData, const std::size_t index) noexcept -> std::size_t {
+		using namespace std::string_view_literals;
+		// the end of the token is left to the DFA, which keeps it correct across windows
+		std::size_t end {std::u8string_view::npos};
+		switch (m_state) {
+			case lx::DfaState::eSingleLineComment:
+				end = rawData.find(u8'\n', index);
+				break;
+			case lx::DfaState::eMultilineComment:
+				end = rawData.find(u8"*/"sv, index);
+				break;
+			case lx::DfaState::eStringLiteral:
+			case lx::DfaState::eCharacterLiteral: {
+				const char8_t quote {m_state == lx::DfaState::eStringLiteral ? u8'"' : u8'\''};
+				const std::optional<std::size_t> quoteIndex {core::findUnescaped(rawData.substr(index), quote)};
+				if (quoteIndex)
+					return index + *quoteIndex;
+				// the trailing backslashes are left to the DFA, so that it knows if the next window starts escaped
+				const std::size_t lastNonBackslash {rawData.find_last_not_of(u8'\\')};
+				return std::max(index, lastNonBackslash == std::u8string_view::npos ? 0uz : lastNonBackslash + 1uz);
 			}
-			else if (activeMultichar == ActiveMultichar::eMultilineComment) {
-				if (lastCharacter != U'*' || character != U'/') {
-					textData.size += size;
-					continue;
-				}
-				co_yield lx::Token{
-					.type = lx::TokenType::eOpenComment,
-					.metadata = {}
-				};
-				co_yield lx::Token{
-					.type = lx::TokenType::eCommentContent,
-					.metadata = rawData.substr(textData.index, textData.size - 1uz)
-				};
-				co_yield lx::Token{
-					.type = lx::TokenType::eCloseComment,
-					.metadata = {}
-				};
-				activeMultichar = ActiveMultichar::eNone;
+			default:
+				return index;
+		}
+		if (end != std::u8string_view::npos)
+			return end;
+		return rawData.size() > index ? rawData.size() - 1uz : index;
+	}
+
+	auto Lexer::dropComment(const lx::DfaAction action, const std::size_t index) noexcept -> bool {
+		if (action != lx::DfaAction::eSingleLineComment && action != lx::DfaAction::eMultilineComment)
+			return false;
+		if (m_options.comments == lx::CommentMode::eEmit)
+			return false;
+
+		const std::size_t start {m_commentOffset.value_or(m_windowOffset + m_tokenIndex)};
+		m_commentOffset = std::nullopt;
+		if (m_options.comments == lx::CommentMode::eRecord && m_options.commentTable != nullptr) {
+			const bool isMultiline {action == lx::DfaAction::eMultilineComment};
+			const std::size_t end {m_windowOffset + index - (isMultiline ? 2uz : 0uz)};
+			m_options.commentTable->push_back({
+				.offset = start + 2uz,
+				.size = end - start - 2uz,
+				.isMultiline = isMultiline
+			});
+		}
+		return true;
+	}
+
+	auto Lexer::lexWindow(const std::u8string_view window, const bool isLastWindow) noexcept
+		-> std::generator<lx::Token>
+	{
+		const std::size_t incompleteSize {isLastWindow ? 0uz : core::getIncompleteUtf8SuffixSize(window)};
+		const std::u8string_view rawData {window.substr(0uz, window.size() - incompleteSize)};
+
+		std::size_t index {this->skipTokenContent(rawData, m_resumeIndex)};
+		while (index < rawData.size()) {
+			const lx::DfaState nextState {lx::lexerDfa.next(m_state, rawData[index])};
+			if (nextState < lx::DfaState::eUnicode) [[likely]] {
+				m_state = nextState;
+				++index;
+				m_tokenIndex = m_state == lx::DfaState::eStart ? index : m_tokenIndex;
+				if (hasSkippableContent(m_state)) [[unlikely]]
+					index = this->skipTokenContent(rawData, index);
 				continue;
 			}
-			else if (activeMultichar == ActiveMultichar::eStartComment) {
-				if (character == U'/') {
-					activeMultichar = ActiveMultichar::eSingleLineComment;
-					textData = {
-						.index = index + size,
-						.size = 0uz
-					};
-					continue;
-				}
-				if (character == U'*') {
-					activeMultichar = ActiveMultichar::eMultilineComment;
-					textData = {
-						.index = index + size,
-						.size = 0uz
-					};
-					continue;
-				}
-				co_yield lx::Token{
-					.type = lx::TokenType::eOperator,
-					.metadata = u8"/"sv
+
+			if (nextState == lx::DfaState::eUnicode) {
+				const std::optional utf32WithAdvance {core::iterativeUtf8ToUtf32(rawData.substr(index))};
+				const char32_t character {utf32WithAdvance ? utf32WithAdvance->first : U'\0'};
+				const std::size_t size {utf32WithAdvance
+					? static_cast<std::size_t> (utf32WithAdvance->second.data() - rawData.data()) - index
+					: 1uz
 				};
-			}
-			else if (activeMultichar == ActiveMultichar::eNumberLiteral) {
-				if (lx::isNumerLiteralCharacters(character)) {
-					textData.size += size;
-					continue;
-				}
-				else if (lastCharacter == U'+') {
-					co_yield lx::Token{
-						.type = lx::TokenType::eOperator,
-						.metadata = u8"+"sv
-					};
-					activeMultichar = ActiveMultichar::eNone;
-				}
-				else if (lastCharacter == U'-') {
-					co_yield lx::Token{
-						.type = lx::TokenType::eOperator,
-						.metadata = u8"-"sv
-					};
-					activeMultichar = ActiveMultichar::eNone;
-				}
-				else if (lastCharacter == U'e' && (character == U'+' || character == U'-')) {
-					textData.size += size;
+				if (m_state == lx::DfaState::eStart) {
+					if (lx::isIdentifierStartCharacters(character))
+						m_state = lx::DfaState::eIdentifier;
+					index += size;
+					m_tokenIndex = m_state == lx::DfaState::eStart ? index : m_tokenIndex;
 					continue;
 				}
-				else co_yield lx::Token{
-					.type = lx::TokenType::eLiteralNumber,
-					.metadata = rawData.substr(textData.index, textData.size)
-				};
-			}
-			else if (activeMultichar == ActiveMultichar::eStringLiteral) {
-				if (character != U'"' || lastCharacter == U'\\') {
-					textData.size += size;
+				if (lx::isIdentifierCharacters(character)) {
+					index += size;
 					continue;
 				}
-				co_yield lx::Token{
-					.type = lx::TokenType::eLiteralString,
-					.metadata = rawData.substr(textData.index, textData.size)
-				};
-				activeMultichar = ActiveMultichar::eNone;
-				continue;
 			}
-			else if (activeMultichar == ActiveMultichar::eCharacterLiteral) {
-				if (character != U'\'' || lastCharacter == U'\\') {
-					textData.size += size;
-					continue;
-				}
-				co_yield lx::Token{
-					.type = lx::TokenType::eLiteralCharacter,
-					.metadata = rawData.substr(textData.index, textData.size)
-				};
-				activeMultichar = ActiveMultichar::eNone;
+			// characters that can't start any token are ignored
+			else if (m_state == lx::DfaState::eStart) {
+				m_tokenIndex = ++index;
 				continue;
 			}
 
-			activeMultichar = ActiveMultichar::eNone;
-			if (lx::isIgnoredCharacters(character))
-				continue;
-			else if (lx::isLineBreakCharacters(character)) co_yield lx::Token{
-				.type = lx::TokenType::eEOL,
-				.metadata = {}
-			};
-			else if (lx::isSpaceCharacters(character))
-				continue;
-			else if (character == U';') co_yield lx::Token{
-				.type = lx::TokenType::eEOS,
-				.metadata = {}
-			};
-			else if (lx::isIdentifierStartCharacters(character)) {
-				textData = {
-					.index = index,
-					.size = size
-				};
-				activeMultichar = ActiveMultichar::eIdentifier;
-			}
-			else if (character == U'/')
-				activeMultichar = ActiveMultichar::eStartComment;
-			else if (lx::isNumerLiteralStartCharacters(character)) {
-				textData = {
-					.index = index,
-					.size = size
-				};
-				activeMultichar = ActiveMultichar::eNumberLiteral;
-			}
-			else if (character == U'"') {
-				textData = {
-					.index = index + size,
-					.size = 0uz
-				};
-				activeMultichar = ActiveMultichar::eStringLiteral;
+			const lx::DfaAction action {lx::lexerDfa.action(m_state)};
+			if (!this->dropComment(action, index)) {
+				const TokenBatch batch {makeTokens(action, rawData.substr(m_tokenIndex, index - m_tokenIndex), m_options.literalArena)};
+				for (std::size_t i {0uz}; i < batch.count; ++i)
+					co_yield batch.tokens[i];
 			}
-			else if (character == U'\'') {
-				textData = {
-					.index = index + size,
-					.size = 0uz
-				};
-				activeMultichar = ActiveMultichar::eCharacterLiteral;
-			}
-			else if (lx::isOperatorCharacters(character)) co_yield lx::Token{
-				.type = lx::TokenType::eOperator,
-				.metadata = rawData.substr(index, size)
-			};
+			m_state = lx::DfaState::eStart;
+			m_tokenIndex = index;
 		}
 
-		co_yield lx::Token{
-			.type = lx::TokenType::eEOF,
-			.metadata = {}
+		if (isLastWindow) {
+			// unterminated comments, strings and characters are dropped
+			const lx::DfaAction action {lx::lexerDfa.action(m_state)};
+			if (this->dropComment(action, rawData.size()))
+				co_return;
+			const TokenBatch batch {makeTokens(action, rawData.substr(m_tokenIndex), m_options.literalArena)};
+			for (std::size_t i {0uz}; i < batch.count; ++i)
+				co_yield batch.tokens[i];
+			co_return;
+		}
+
+		// only keep the unfinished token and the incomplete UTF-8 sequence for the next window. The
+		// text of dropped comments isn't needed, only their state and start offset
+		std::size_t keptIndex {m_state == lx::DfaState::eStart ? rawData.size() : m_tokenIndex};
+		const bool isInComment {m_state >= lx::DfaState::eSingleLineComment && m_state <= lx::DfaState::eMultilineCommentEnd};
+		if (isInComment && m_options.comments != lx::CommentMode::eEmit) {
+			m_commentOffset = m_commentOffset.value_or(m_windowOffset + m_tokenIndex);
+			keptIndex = rawData.size();
+		}
+		m_resumeIndex = rawData.size() - keptIndex;
+		m_windowOffset += keptIndex;
+		m_tokenIndex = 0uz;
+		if (window.data() == m_pending.data())
+			m_pending.erase(0uz, keptIndex);
+		else
+			m_pending.assign(window.substr(keptIndex));
+	}
+
+	auto lex(const std::u8string_view rawData, const lx::LexerOptions options) noexcept -> std::generator<lx::Token> {
+		lx::Lexer lexer {options};
+		co_yield std::ranges::elements_of(lexer.finish(rawData));
+	}
+
+	auto lexPipelined(const std::u8string_view rawData, const lx::LexerOptions options) noexcept
+		-> std::generator<lx::Token>
+	{
+		struct TokenBlock {
+			std::array<lx::Token, 256uz> tokens;
+			std::size_t count;
 		};
+		using TokenQueue = core::SpscQueue<TokenBlock, 64uz>;
+
+		auto queue {std::make_unique<TokenQueue> ()};
+		std::jthread producer {[&queue = *queue, rawData, options] () noexcept {
+			TokenBlock block {};
+			for (const auto& token : lx::lex(rawData, options)) {
+				block.tokens[block.count++] = token;
+				if (block.count != block.tokens.size())
+					continue;
+				if (!queue.push(std::move(block)))
+					return;
+				block.count = 0uz;
+			}
+			if (block.count != 0uz)
+				queue.push(std::move(block));
+			queue.close();
+		}};
+		// closing the queue first unblocks the producer if the consumer stops early
+		core::Janitor _ {[&queue]() noexcept {queue->close();}};
+
+		while (const std::optional block {queue->pop()}) {
+			for (std::size_t i {0uz}; i < block->count; ++i)
+				co_yield block->tokens[i];
+		}
 	}
 }
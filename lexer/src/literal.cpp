@@ -0,0 +1,126 @@
+#include "volt/lx/literal.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+
+namespace volt::lx {
+	namespace {
+		auto getHexDigitValue(const char8_t character) noexcept -> std::optional<char32_t> {
+			if (character >= u8'0' && character <= u8'9')
+				return static_cast<char32_t> (character - u8'0');
+			if (character >= u8'a' && character <= u8'f')
+				return static_cast<char32_t> (character - u8'a' + 10);
+			if (character >= u8'A' && character <= u8'F')
+				return static_cast<char32_t> (character - u8'A' + 10);
+			return std::nullopt;
+		}
+
+		auto writeUtf8(char8_t* output, const char32_t character) noexcept -> std::size_t {
+			const auto value {static_cast<std::size_t> (character)};
+			if (value <= 0x7f) {
+				output[0] = static_cast<char8_t> (value);
+				return 1uz;
+			}
+			if (value <= 0x7ff) {
+				output[0] = static_cast<char8_t> ((value >> 6uz) | 0b1100'0000);
+				output[1] = static_cast<char8_t> ((value & 0b0011'1111) | 0b1000'0000);
+				return 2uz;
+			}
+			if (value <= 0xffff) {
+				output[0] = static_cast<char8_t> ((value >> 12uz) | 0b1110'0000);
+				output[1] = static_cast<char8_t> (((value >> 6uz) & 0b0011'1111) | 0b1000'0000);
+				output[2] = static_cast<char8_t> ((value & 0b0011'1111) | 0b1000'0000);
+				return 3uz;
+			}
+			output[0] = static_cast<char8_t> ((value >> 18uz) | 0b1111'0000);
+			output[1] = static_cast<char8_t> (((value >> 12uz) & 0b0011'1111) | 0b1000'0000);
+			output[2] = static_cast<char8_t> (((value >> 6uz) & 0b0011'1111) | 0b1000'0000);
+			output[3] = static_cast<char8_t> ((value & 0b0011'1111) | 0b1000'0000);
+			return 4uz;
+		}
+
+		struct DecodedEscape {
+			char32_t character;
+			//! size of the escape sequence, backslash included
+			std::size_t size;
+			bool isCodePoint;
+		};
+
+		auto decodeEscape(const std::u8string_view escape) noexcept -> std::optional<DecodedEscape> {
+			if (escape.size() < 2uz)
+				return std::nullopt;
+			switch (escape[1]) {
+				case u8'n':  return DecodedEscape{.character = U'\n', .size = 2uz, .isCodePoint = true};
+				case u8't':  return DecodedEscape{.character = U'\t', .size = 2uz, .isCodePoint = true};
+				case u8'r':  return DecodedEscape{.character = U'\r', .size = 2uz, .isCodePoint = true};
+				case u8'0':  return DecodedEscape{.character = U'\0', .size = 2uz, .isCodePoint = true};
+				case u8'\\': return DecodedEscape{.character = U'\\', .size = 2uz, .isCodePoint = true};
+				case u8'\'': return DecodedEscape{.character = U'\'', .size = 2uz, .isCodePoint = true};
+				case u8'"':  return DecodedEscape{.character = U'"', .size = 2uz, .isCodePoint = true};
+				case u8'x': {
+					if (escape.size() < 4uz)
+						return std::nullopt;
+					const std::optional<char32_t> high {getHexDigitValue(escape[2])};
+					const std::optional<char32_t> low {getHexDigitValue(escape[3])};
+					if (!high || !low)
+						return std::nullopt;
+					// \x is a raw byte, and may not be valid UTF-8 on its own
+					return DecodedEscape{.character = (*high << 4) | *low, .size = 4uz, .isCodePoint = false};
+				}
+				case u8'u': {
+					if (escape.size() < 5uz || escape[2] != u8'{')
+						return std::nullopt;
+					char32_t character {0};
+					std::size_t index {3uz};
+					for (; index < std::min(escape.size(), 9uz) && escape[index] != u8'}'; ++index) {
+						const std::optional<char32_t> digit {getHexDigitValue(escape[index])};
+						if (!digit)
+							return std::nullopt;
+						character = (character << 4) | *digit;
+					}
+					if (index == 3uz || index == escape.size() || escape[index] != u8'}')
+						return std::nullopt;
+					if (character > 0x10ffff || (character >= 0xd800 && character <= 0xdfff))
+						return std::nullopt;
+					return DecodedEscape{.character = character, .size = index + 1uz, .isCodePoint = true};
+				}
+				default:
+					return std::nullopt;
+			}
+		}
+	}
+
+
+	auto decodeLiteral(const std::u8string_view content, core::Arena& arena) noexcept -> std::u8string_view {
+		// no escape produces more bytes than it takes, so the raw size is enough
+		auto* const output {reinterpret_cast<char8_t*> (arena.allocate(content.size(), alignof(char8_t)))};
+		std::size_t outputSize {0uz};
+		std::size_t index {0uz};
+		while (index < content.size()) {
+			const std::size_t escapeIndex {std::min(content.find(u8'\\', index), content.size())};
+			std::copy(content.begin() + index, content.begin() + escapeIndex, output + outputSize);
+			outputSize += escapeIndex - index;
+			index = escapeIndex;
+			if (index == content.size())
+				break;
+
+			const std::optional<DecodedEscape> escape {decodeEscape(content.substr(index))};
+			if (!escape) {
+				const std::size_t size {std::min(content.size() - index, 2uz)};
+				std::copy(content.begin() + index, content.begin() + index + size, output + outputSize);
+				outputSize += size;
+				index += size;
+				continue;
+			}
+			if (escape->isCodePoint)
+				outputSize += writeUtf8(output + outputSize, escape->character);
+			else
+				output[outputSize++] = static_cast<char8_t> (escape->character);
+			index += escape->size;
+		}
+		return std::u8string_view{output, outputSize};
+	}
+}
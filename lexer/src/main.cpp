@@ -1,6 +1,10 @@
+#include <filesystem>
 #include <print>
 #include <string>
+#include <vector>
 
+#include <volt/core/file_reader.hpp>
+#include <volt/core/thread_pool.hpp>
 #include <volt/lx/lexer.hpp>
 #include <volt/lx/token.hpp>
 
@@ -9,7 +13,32 @@ auto toSv(std::u8string_view view) {
 }
 
 
-auto main(int, char**) -> int {
+auto lexFiles(const std::vector<std::filesystem::path>& paths) -> int {
+	volt::core::ThreadPool pool {};
+	volt::core::FileReader reader {pool};
+	int result {0};
+	// each file is lexed as soon as it has been read, while the next ones are still being read
+	for (const auto& file : reader.read(paths)) {
+		if (!file.content) {
+			std::println(stderr, "Can't read file '{}'", paths[file.index].string());
+			result = 1;
+			continue;
+		}
+		std::size_t tokenCount {0uz};
+		for (const auto& token : volt::lx::lex(*file.content)) {
+			(void)token;
+			++tokenCount;
+		}
+		std::println("{}: {} tokens", paths[file.index].string(), tokenCount);
+	}
+	return result;
+}
+
+
+auto main(int argc, char** argv) -> int {
+	if (argc > 1)
+		return lexFiles(std::vector<std::filesystem::path> (argv + 1, argv + argc));
+
 	std::u8string text {
 		u8"hello= -1_0e+20;\n"
 		u8"1+2;\n"
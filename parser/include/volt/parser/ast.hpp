@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 
+#include "volt/core/type_registry.hpp"
+#include "volt/lx/token.hpp"
+
 
 namespace volt::parser {
 	class ASTUnaryOperatorNode;
@@ -176,6 +182,11 @@ namespace volt::parser {
 				m_identifier {},
 				m_inCodeText {std::move(inCodeText)}
 			{}
+			inline ASTTypeNode(const core::TypeDescriptor& descriptor, std::u8string&& inCodeText) noexcept :
+				m_UUID {descriptor.UUID},
+				m_identifier {descriptor.identifier},
+				m_inCodeText {std::move(inCodeText)}
+			{}
 			inline ~ASTTypeNode() override = default;
 
 			inline auto visit(parser::ASTVisitor& visitor) noexcept -> void override {
@@ -196,4 +207,78 @@ namespace volt::parser {
 			std::u8string_view m_identifier;
 			std::u8string m_inCodeText;
 	};
+
+	/**
+	 * @brief A reference to a canonical comptime expression, shared between structurally identical subtrees
+	 *
+	 * Visiting the reference visits the canonical node, so that visitors don't need to know about
+	 * hash-consing. The canonical node is owned by a `parser::ComptimeExpressionTable`.
+	 * */
+	class ASTComptimeReferenceNode final : public parser::ASTComptimeExpressionNode {
+		public:
+			inline ASTComptimeReferenceNode(parser::ASTExpressionNode& canonical, std::size_t structuralHash) noexcept :
+				m_canonical {canonical},
+				m_structuralHash {structuralHash}
+			{}
+			inline ~ASTComptimeReferenceNode() override = default;
+
+			inline auto visit(parser::ASTVisitor& visitor) noexcept -> void override {
+				m_canonical.visit(visitor);
+			}
+			inline auto getCanonical() const noexcept -> parser::ASTExpressionNode& {
+				return m_canonical;
+			}
+			inline auto getStructuralHash() const noexcept -> std::size_t {
+				return m_structuralHash;
+			}
+
+		private:
+			parser::ASTExpressionNode& m_canonical;
+			std::size_t m_structuralHash;
+	};
+
+	using BodyParser = auto (*)(std::span<const lx::Token> tokens) noexcept -> std::unique_ptr<parser::ASTNode>;
+
+	/**
+	 * @brief The body of a function, kept as tokens until it is first needed
+	 *
+	 * The body is parsed with `parseBody` the first time it is visited or queried, which may happen
+	 * concurrently. The tokens must outlive the node.
+	 * */
+	class ASTLazyFunctionBodyNode final : public parser::ASTStatementNode {
+		public:
+			inline ASTLazyFunctionBodyNode(std::span<const lx::Token> tokens, parser::BodyParser parseBody) noexcept :
+				m_tokens {tokens},
+				m_parseBody {parseBody},
+				m_parseFlag {},
+				m_isParsed {false},
+				m_body {}
+			{}
+			inline ~ASTLazyFunctionBodyNode() override = default;
+
+			inline auto visit(parser::ASTVisitor& visitor) noexcept -> void override {
+				if (parser::ASTNode* body {this->getBody()}; body != nullptr)
+					body->visit(visitor);
+			}
+			inline auto getBody() noexcept -> parser::ASTNode* {
+				std::call_once(m_parseFlag, [this] () noexcept {
+					m_body = m_parseBody(m_tokens);
+					m_isParsed.store(true, std::memory_order_release);
+				});
+				return m_body.get();
+			}
+			inline auto isParsed() const noexcept -> bool {
+				return m_isParsed.load(std::memory_order_acquire);
+			}
+			inline auto getTokens() const noexcept -> std::span<const lx::Token> {
+				return m_tokens;
+			}
+
+		private:
+			std::span<const lx::Token> m_tokens;
+			parser::BodyParser m_parseBody;
+			std::once_flag m_parseFlag;
+			std::atomic_bool m_isParsed;
+			std::unique_ptr<parser::ASTNode> m_body;
+	};
 }
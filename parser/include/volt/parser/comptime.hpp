@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "volt/parser/ast.hpp"
+#include "volt/parser/export.hpp"
+
+
+namespace volt::parser {
+	/**
+	 * @brief Hash-consing table of comptime expressions
+	 *
+	 * Structurally identical expressions built through the table share a single canonical node, as long
+	 * as their literals and types are spelled the same way, so that nodes keep reporting the source. The
+	 * table hands out `ASTComptimeReferenceNode`s to the canonical nodes, and must outlive them.
+	 * */
+	class ComptimeExpressionTable final {
+		public:
+			ComptimeExpressionTable(const ComptimeExpressionTable&) = delete;
+			auto operator=(const ComptimeExpressionTable&) -> ComptimeExpressionTable& = delete;
+			ComptimeExpressionTable(ComptimeExpressionTable&&) = delete;
+			auto operator=(ComptimeExpressionTable&&) -> ComptimeExpressionTable& = delete;
+
+			inline ComptimeExpressionTable() noexcept = default;
+			inline ~ComptimeExpressionTable() = default;
+
+			VOLT_PARSER_EXPORT auto makeIntegerLiteral(__int128 value, std::u8string_view inCodeText) noexcept
+				-> std::unique_ptr<parser::ASTComptimeReferenceNode>;
+			VOLT_PARSER_EXPORT auto makeType(std::size_t UUID, std::u8string_view inCodeText) noexcept
+				-> std::unique_ptr<parser::ASTComptimeReferenceNode>;
+			VOLT_PARSER_EXPORT auto makeUnaryOperator(
+				parser::UnaryOperator operator_,
+				const parser::ASTComptimeReferenceNode& child
+			) noexcept -> std::unique_ptr<parser::ASTComptimeReferenceNode>;
+			VOLT_PARSER_EXPORT auto makeBinaryOperator(
+				parser::BinaryOperator operator_,
+				const parser::ASTComptimeReferenceNode& leftChild,
+				const parser::ASTComptimeReferenceNode& rightChild
+			) noexcept -> std::unique_ptr<parser::ASTComptimeReferenceNode>;
+
+			inline auto getCanonicalCount() const noexcept -> std::size_t {
+				return m_entries.size();
+			}
+
+		private:
+			enum class Kind : std::uint8_t {
+				eIntegerLiteral,
+				eType,
+				eUnaryOperator,
+				eBinaryOperator,
+			};
+			struct Key {
+				Kind kind;
+				std::uint32_t operator_;
+				//! the literal value or type UUID, or the structural hashes of the children of operators
+				__int128 value;
+				const parser::ASTExpressionNode* leftChild;
+				const parser::ASTExpressionNode* rightChild;
+				//! the spelling of literals and types is part of the key, so that canonical nodes keep it
+				std::u8string inCodeText;
+				std::size_t structuralHash;
+
+				constexpr auto operator==(const Key& other) const noexcept -> bool {
+					return kind == other.kind
+						&& operator_ == other.operator_
+						&& value == other.value
+						&& leftChild == other.leftChild
+						&& rightChild == other.rightChild
+						&& inCodeText == other.inCodeText;
+				}
+			};
+			struct KeyHash {
+				constexpr auto operator()(const Key& key) const noexcept -> std::size_t {
+					return key.structuralHash;
+				}
+			};
+
+			template <typename Factory>
+			auto intern(Key key, Factory&& makeNode) noexcept -> std::unique_ptr<parser::ASTComptimeReferenceNode>;
+
+			std::unordered_map<Key, std::unique_ptr<parser::ASTExpressionNode>, KeyHash> m_entries;
+	};
+
+
+	/**
+	 * @brief Memoization of the evaluation of comptime expressions, per canonical node
+	 * */
+	template <typename Value>
+	class ComptimeEvaluationCache final {
+		public:
+			inline ComptimeEvaluationCache() noexcept = default;
+			inline ~ComptimeEvaluationCache() = default;
+
+			template <typename Evaluate>
+			requires std::is_invocable_r_v<Value, Evaluate, parser::ASTExpressionNode&>
+			auto evaluate(const parser::ASTComptimeReferenceNode& node, Evaluate&& evaluate) noexcept -> const Value& {
+				parser::ASTExpressionNode& canonical {node.getCanonical()};
+				const auto value {m_values.find(&canonical)};
+				if (value != m_values.end())
+					return value->second;
+				return m_values.emplace(&canonical, std::invoke(std::forward<Evaluate> (evaluate), canonical)).first->second;
+			}
+
+		private:
+			std::unordered_map<const parser::ASTExpressionNode*, Value> m_values;
+	};
+}
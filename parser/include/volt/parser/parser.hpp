@@ -1,11 +1,35 @@
 #pragma once
 
+#include <cstddef>
 #include <generator>
+#include <span>
+#include <vector>
 
 #include "volt/lx/token.hpp"
 #include "volt/parser/ast.hpp"
+#include "volt/parser/export.hpp"
 
 
 namespace volt::parser {
 	auto parse(std::generator<lx::Token>&& tokens) noexcept -> std::unique_ptr<parser::ASTNode>;
+
+	struct FunctionBodyRange {
+		//! index of the `func` keyword
+		std::size_t function;
+		//! index of the opening brace of the body
+		std::size_t begin;
+		//! index right after the closing brace of the body
+		std::size_t end;
+	};
+
+	/**
+	 * @brief Find the bodies of the top-level functions by only counting braces
+	 *
+	 * Nested functions belong to the body of their parent. A body must open on the line of its
+	 * signature, functions without one are skipped, and a body that is never closed extends to the
+	 * end of the tokens. The ranges can be turned into
+	 * `parser::ASTLazyFunctionBodyNode`s, so that only the bodies actually used get parsed.
+	 * */
+	VOLT_PARSER_EXPORT auto skimFunctionBodies(std::span<const lx::Token> tokens) noexcept
+		-> std::vector<parser::FunctionBodyRange>;
 }
@@ -1,5 +1,16 @@
 #pragma once
 
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <future>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "volt/core/thread_pool.hpp"
+
 #include "volt/parser/ast.hpp"
 #include "volt/parser/export.hpp"
 
@@ -20,4 +31,196 @@ namespace volt::parser {
 		private:
 			ASTVisitor& m_visitor;
 	};
+
+
+	/**
+	 * @brief A list of visitor types, used to declare the ordering constraints of a visitor
+	 *
+	 * A visitor can declare `using VisitAfter = parser::VisitorList<...>` if it must see each node
+	 * after the listed visitors, and `using VisitAfterCompletion = parser::VisitorList<...>` if the
+	 * listed visitors must have visited the whole tree before it starts.
+	 * */
+	template <typename... Visitors>
+	struct VisitorList {
+		static constexpr std::size_t size {sizeof...(Visitors)};
+
+		//! index of the first occurrence of `Visitor`, or `size` if it isn't in the list
+		template <typename Visitor>
+		static constexpr std::size_t indexOf {[] {
+			const std::array<bool, sizeof...(Visitors)> matches {std::is_same_v<Visitor, Visitors>...};
+			for (std::size_t i {0uz}; i < matches.size(); ++i) {
+				if (matches[i])
+					return i;
+			}
+			return matches.size();
+		} ()};
+	};
+
+	/**
+	 * @brief Run several visitors in a single traversal
+	 *
+	 * Each node is dispatched to every visitor, in the order of `Visitors`, before the traversal
+	 * moves on. Nodes are reached in the same order as with `ASTTraversalVisitor`. Visitors can be
+	 * given with their concrete type, which lets the calls be devirtualized, or as `ASTVisitor`.
+	 * The ordering constraints declared by the visitors are checked at compile time.
+	 * */
+	template <typename... Visitors>
+	requires (std::derived_from<Visitors, parser::ASTVisitor> && ...)
+	class ASTFusedTraversalVisitor final : public parser::ASTVisitor {
+		public:
+			inline ASTFusedTraversalVisitor(Visitors&... visitors) noexcept :
+				m_visitors {visitors...}
+			{
+				static_assert(isVisitAfterRespected(), "A visitor is fused before a visitor it must visit nodes after");
+				static_assert(isVisitAfterCompletionRespected(), "A visitor is fused with a visitor that must complete before it");
+			}
+			constexpr ~ASTFusedTraversalVisitor() override = default;
+
+			inline auto accept(parser::ASTUnaryOperatorNode& node) noexcept -> void override {
+				this->dispatch(node);
+				node.getChild().visit(*this);
+			}
+			inline auto accept(parser::ASTBinaryOperatorNode& node) noexcept -> void override {
+				node.getLeftChild().visit(*this);
+				this->dispatch(node);
+				node.getRightChild().visit(*this);
+			}
+			inline auto accept(parser::ASTIntegerLiteral& node) noexcept -> void override {
+				this->dispatch(node);
+			}
+			inline auto accept(parser::ASTTypeNode& node) noexcept -> void override {
+				this->dispatch(node);
+			}
+
+		private:
+			using Order = parser::VisitorList<Visitors...>;
+
+			template <typename Visitor>
+			static consteval auto getVisitAfter() noexcept {
+				if constexpr (requires {typename Visitor::VisitAfter;})
+					return typename Visitor::VisitAfter {};
+				else
+					return parser::VisitorList<> {};
+			}
+			template <typename Visitor>
+			static consteval auto getVisitAfterCompletion() noexcept {
+				if constexpr (requires {typename Visitor::VisitAfterCompletion;})
+					return typename Visitor::VisitAfterCompletion {};
+				else
+					return parser::VisitorList<> {};
+			}
+
+			// visitors that aren't fused are expected to have run in an earlier traversal
+			template <std::size_t Index, typename... Dependencies>
+			static consteval auto isFusedAfter(parser::VisitorList<Dependencies...>) noexcept -> bool {
+				return ((Order::template indexOf<Dependencies> < Index
+					|| Order::template indexOf<Dependencies> == Order::size) && ...);
+			}
+			template <typename... Dependencies>
+			static consteval auto isNotFused(parser::VisitorList<Dependencies...>) noexcept -> bool {
+				return ((Order::template indexOf<Dependencies> == Order::size) && ...);
+			}
+
+			static consteval auto isVisitAfterRespected() noexcept -> bool {
+				return [] <std::size_t... Indices> (std::index_sequence<Indices...>) {
+					return (isFusedAfter<Indices> (getVisitAfter<Visitors> ()) && ...);
+				} (std::index_sequence_for<Visitors...> {});
+			}
+			static consteval auto isVisitAfterCompletionRespected() noexcept -> bool {
+				return (isNotFused(getVisitAfterCompletion<Visitors> ()) && ...);
+			}
+
+			template <typename Node>
+			inline auto dispatch(Node& node) noexcept -> void {
+				std::apply([&node] (auto&... visitors) {(visitors.accept(node), ...);}, m_visitors);
+			}
+
+			std::tuple<Visitors&...> m_visitors;
+	};
+
+
+	/**
+	 * @brief A part of a task of a parallel traversal
+	 *
+	 * Either a whole subtree to traverse, or a single node whose children are split into other
+	 * items.
+	 * */
+	struct ParallelTraversalItem {
+		parser::ASTNode* node;
+		std::size_t nodeCount;
+		bool isWholeSubtree;
+	};
+
+	//! consecutive items, in traversal order, handled by a single task
+	struct ParallelTraversalTask {
+		std::vector<parser::ParallelTraversalItem> items;
+		std::size_t nodeCount;
+	};
+
+	/**
+	 * @brief Split a tree into tasks of about `taskSize` nodes
+	 *
+	 * The tasks and their items are returned in the order `ASTTraversalVisitor` would visit them.
+	 * A tree of at most `taskSize` nodes is returned as a single task, without being fully walked.
+	 * */
+	VOLT_PARSER_EXPORT auto splitForParallelTraversal(parser::ASTNode& root, std::size_t taskSize) noexcept
+		-> std::vector<parser::ParallelTraversalTask>;
+
+	template <typename Visitor>
+	concept ReducibleVisitor = std::derived_from<Visitor, parser::ASTVisitor> && requires(Visitor& visitor) {
+		{visitor.getResult()} -> std::movable;
+	};
+
+	struct ParallelTraversalOptions {
+		//! number of nodes traversed by a single task, trees up to this size aren't split
+		std::size_t sequentialThreshold {1024uz};
+	};
+
+	/**
+	 * @brief Run a read-only visitor pass over a tree using a thread pool
+	 *
+	 * Each task gets its own visitor built by `makeVisitor`, which is called concurrently from the
+	 * threads of the pool. The results of the tasks are merged with `reduce` in traversal order, so
+	 * `reduce` only needs to be associative.
+	 * */
+	template <typename Factory, typename Reduce>
+	requires parser::ReducibleVisitor<std::invoke_result_t<Factory&>>
+	auto traverseInParallel(
+		core::ThreadPool& threadPool,
+		parser::ASTNode& root,
+		Factory&& makeVisitor,
+		Reduce&& reduce,
+		const parser::ParallelTraversalOptions& options = {}
+	) noexcept {
+		using Visitor = std::invoke_result_t<Factory&>;
+		using Result = std::remove_cvref_t<decltype(std::declval<Visitor&> ().getResult())>;
+
+		const auto traverse {[&makeVisitor] (const parser::ParallelTraversalTask& task) -> Result {
+			Visitor visitor {makeVisitor()};
+			parser::ASTTraversalVisitor traversalVisitor {visitor};
+			for (const auto& [node, nodeCount, isWholeSubtree] : task.items) {
+				if (isWholeSubtree)
+					node->visit(traversalVisitor);
+				else
+					node->visit(visitor);
+			}
+			return visitor.getResult();
+		}};
+
+		const std::vector<parser::ParallelTraversalTask> tasks {
+			parser::splitForParallelTraversal(root, options.sequentialThreshold)
+		};
+		if (tasks.size() == 1uz)
+			return traverse(tasks[0]);
+
+		std::vector<std::future<Result>> results {};
+		results.reserve(tasks.size());
+		for (const auto& task : tasks)
+			results.push_back(threadPool.submit([&traverse, &task] {return traverse(task);}));
+
+		Result result {results[0].get()};
+		for (std::size_t i {1uz}; i < results.size(); ++i)
+			result = reduce(std::move(result), results[i].get());
+		return result;
+	}
 }
@@ -0,0 +1,107 @@
+#include "volt/parser/comptime.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+
+namespace volt::parser {
+	namespace {
+		constexpr auto combineHash(const std::size_t seed, const std::size_t hash) noexcept -> std::size_t {
+			return seed ^ (hash + 0x9e37'79b9'7f4a'7c15uz + (seed << 6uz) + (seed >> 2uz));
+		}
+
+		constexpr auto hashInt128(const __int128 value) noexcept -> std::size_t {
+			const auto unsignedValue {static_cast<unsigned __int128> (value)};
+			return combineHash(
+				static_cast<std::size_t> (unsignedValue),
+				static_cast<std::size_t> (unsignedValue >> 64uz)
+			);
+		}
+	}
+
+
+	template <typename Factory>
+	auto ComptimeExpressionTable::intern(Key key, Factory&& makeNode) noexcept
+		-> std::unique_ptr<parser::ASTComptimeReferenceNode>
+	{
+		key.structuralHash = combineHash(
+			combineHash(
+				combineHash(static_cast<std::size_t> (key.kind), static_cast<std::size_t> (key.operator_)),
+				hashInt128(key.value)
+			),
+			std::hash<std::u8string> {} (key.inCodeText)
+		);
+		auto entry {m_entries.find(key)};
+		if (entry == m_entries.end())
+			entry = m_entries.emplace(std::move(key), makeNode()).first;
+		return std::make_unique<parser::ASTComptimeReferenceNode> (*entry->second, entry->first.structuralHash);
+	}
+
+	auto ComptimeExpressionTable::makeIntegerLiteral(const __int128 value, const std::u8string_view inCodeText) noexcept
+		-> std::unique_ptr<parser::ASTComptimeReferenceNode>
+	{
+		return this->intern(
+			Key{.kind = Kind::eIntegerLiteral, .operator_ = 0u, .value = value, .leftChild = nullptr, .rightChild = nullptr,
+				.inCodeText = std::u8string{inCodeText}, .structuralHash = 0uz},
+			[&] {return std::make_unique<parser::ASTIntegerLiteral> (value, std::u8string{inCodeText});}
+		);
+	}
+
+	auto ComptimeExpressionTable::makeType(const std::size_t UUID, const std::u8string_view inCodeText) noexcept
+		-> std::unique_ptr<parser::ASTComptimeReferenceNode>
+	{
+		return this->intern(
+			Key{.kind = Kind::eType, .operator_ = 0u, .value = UUID, .leftChild = nullptr, .rightChild = nullptr,
+				.inCodeText = std::u8string{inCodeText}, .structuralHash = 0uz},
+			[&] {return std::make_unique<parser::ASTTypeNode> (UUID, std::u8string{inCodeText});}
+		);
+	}
+
+	auto ComptimeExpressionTable::makeUnaryOperator(
+		const parser::UnaryOperator operator_,
+		const parser::ASTComptimeReferenceNode& child
+	) noexcept -> std::unique_ptr<parser::ASTComptimeReferenceNode> {
+		return this->intern(
+			Key{
+				.kind = Kind::eUnaryOperator,
+				.operator_ = static_cast<std::uint32_t> (operator_),
+				.value = static_cast<__int128> (child.getStructuralHash()),
+				.leftChild = &child.getCanonical(),
+				.rightChild = nullptr,
+				.inCodeText = {},
+				.structuralHash = 0uz
+			},
+			[&] {return std::make_unique<parser::ASTUnaryOperatorNode> (
+				operator_,
+				std::make_unique<parser::ASTComptimeReferenceNode> (child.getCanonical(), child.getStructuralHash())
+			);}
+		);
+	}
+
+	auto ComptimeExpressionTable::makeBinaryOperator(
+		const parser::BinaryOperator operator_,
+		const parser::ASTComptimeReferenceNode& leftChild,
+		const parser::ASTComptimeReferenceNode& rightChild
+	) noexcept -> std::unique_ptr<parser::ASTComptimeReferenceNode> {
+		return this->intern(
+			Key{
+				.kind = Kind::eBinaryOperator,
+				.operator_ = static_cast<std::uint32_t> (operator_),
+				.value = (static_cast<__int128> (leftChild.getStructuralHash()) << 64)
+					| static_cast<__int128> (rightChild.getStructuralHash()),
+				.leftChild = &leftChild.getCanonical(),
+				.rightChild = &rightChild.getCanonical(),
+				.inCodeText = {},
+				.structuralHash = 0uz
+			},
+			[&] {return std::make_unique<parser::ASTBinaryOperatorNode> (
+				operator_,
+				std::make_unique<parser::ASTComptimeReferenceNode> (leftChild.getCanonical(), leftChild.getStructuralHash()),
+				std::make_unique<parser::ASTComptimeReferenceNode> (rightChild.getCanonical(), rightChild.getStructuralHash())
+			);}
+		);
+	}
+}
@@ -0,0 +1,61 @@
+#include "volt/parser/parser.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <variant>
+
+
+namespace volt::parser {
+	namespace {
+		auto isOperator(const lx::Token& token, const std::u8string_view operator_) noexcept -> bool {
+			if (token.type != lx::TokenType::eOperator)
+				return false;
+			const auto* text {std::get_if<std::u8string_view> (&token.metadata)};
+			return text != nullptr && *text == operator_;
+		}
+	}
+
+
+	auto skimFunctionBodies(const std::span<const lx::Token> tokens) noexcept -> std::vector<parser::FunctionBodyRange> {
+		std::vector<parser::FunctionBodyRange> ranges {};
+		std::size_t index {0uz};
+		while (index < tokens.size()) {
+			if (tokens[index].type != lx::TokenType::eKeywordFunc) {
+				++index;
+				continue;
+			}
+
+			// the body must open on the line of the signature, which only spans several lines inside
+			// its parameter list
+			const std::size_t function {index++};
+			std::size_t parenthesisDepth {0uz};
+			for (; index < tokens.size(); ++index) {
+				const lx::Token& token {tokens[index]};
+				if (token.type == lx::TokenType::eEOS || token.type == lx::TokenType::eKeywordFunc)
+					break;
+				if (token.type == lx::TokenType::eEOL && parenthesisDepth == 0uz)
+					break;
+				if (isOperator(token, u8"{") && parenthesisDepth == 0uz)
+					break;
+				if (isOperator(token, u8"("))
+					++parenthesisDepth;
+				else if (isOperator(token, u8")") && parenthesisDepth != 0uz)
+					--parenthesisDepth;
+			}
+			if (index == tokens.size() || !isOperator(tokens[index], u8"{"))
+				continue;
+
+			const std::size_t begin {index};
+			std::size_t depth {0uz};
+			for (; index < tokens.size(); ++index) {
+				if (isOperator(tokens[index], u8"{"))
+					++depth;
+				else if (isOperator(tokens[index], u8"}") && --depth == 0uz)
+					break;
+			}
+			index = std::min(index + 1uz, tokens.size());
+			ranges.push_back({.function = function, .begin = begin, .end = index});
+		}
+		return ranges;
+	}
+}
@@ -1,5 +1,10 @@
 #include "volt/parser/visitor.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
 
 namespace volt::parser {
 	auto ASTTraversalVisitor::accept(parser::ASTUnaryOperatorNode& node) noexcept -> void {
@@ -20,4 +25,142 @@ namespace volt::parser {
 	auto ASTTraversalVisitor::accept(parser::ASTTypeNode& node) noexcept -> void {
 		node.visit(m_visitor);
 	}
+
+
+	namespace {
+		//! counts the nodes of a tree, but stops as soon as there are more than `maxCount`
+		class BoundedSizeVisitor final : public parser::ASTVisitor {
+			public:
+				inline BoundedSizeVisitor(std::size_t maxCount) noexcept :
+					m_maxCount {maxCount},
+					m_count {0uz}
+				{}
+				inline ~BoundedSizeVisitor() override = default;
+
+				inline auto accept(parser::ASTUnaryOperatorNode& node) noexcept -> void override {
+					if (this->count())
+						node.getChild().visit(*this);
+				}
+				inline auto accept(parser::ASTBinaryOperatorNode& node) noexcept -> void override {
+					if (this->count())
+						node.getLeftChild().visit(*this);
+					if (m_count <= m_maxCount)
+						node.getRightChild().visit(*this);
+				}
+				inline auto accept(parser::ASTIntegerLiteral&) noexcept -> void override {
+					this->count();
+				}
+				inline auto accept(parser::ASTTypeNode&) noexcept -> void override {
+					this->count();
+				}
+
+				inline auto isLarger() const noexcept -> bool {
+					return m_count > m_maxCount;
+				}
+				inline auto getCount() const noexcept -> std::size_t {
+					return m_count;
+				}
+
+			private:
+				inline auto count() noexcept -> bool {
+					return ++m_count <= m_maxCount;
+				}
+
+				std::size_t m_maxCount;
+				std::size_t m_count;
+		};
+
+		/*
+		 * Walks the tree once, without storing the size of the subtrees. The items of a subtree are
+		 * pushed as soon as they are reached, and replaced by a single whole subtree item once the
+		 * subtree turns out to be small enough.
+		 * */
+		class ParallelSplitVisitor final : public parser::ASTVisitor {
+			public:
+				inline ParallelSplitVisitor(std::size_t maxSubtreeSize) noexcept :
+					m_maxSubtreeSize {maxSubtreeSize},
+					m_subtreeSize {},
+					m_items {}
+				{}
+				inline ~ParallelSplitVisitor() override = default;
+
+				inline auto accept(parser::ASTUnaryOperatorNode& node) noexcept -> void override {
+					const std::size_t firstItem {m_items.size()};
+					m_items.push_back({.node = &node, .nodeCount = 1uz, .isWholeSubtree = false});
+					const std::optional<std::size_t> childSize {this->split(node.getChild())};
+					this->mergeIfSmallEnough(firstItem, childSize.transform([] (std::size_t size) {return size + 1uz;}));
+				}
+				inline auto accept(parser::ASTBinaryOperatorNode& node) noexcept -> void override {
+					const std::size_t firstItem {m_items.size()};
+					const std::optional<std::size_t> leftSize {this->split(node.getLeftChild())};
+					m_items.push_back({.node = &node, .nodeCount = 1uz, .isWholeSubtree = false});
+					const std::optional<std::size_t> rightSize {this->split(node.getRightChild())};
+					this->mergeIfSmallEnough(firstItem, leftSize && rightSize
+						? std::optional{*leftSize + *rightSize + 1uz}
+						: std::nullopt
+					);
+				}
+				inline auto accept(parser::ASTIntegerLiteral&) noexcept -> void override {
+					m_subtreeSize = 1uz;
+				}
+				inline auto accept(parser::ASTTypeNode&) noexcept -> void override {
+					m_subtreeSize = 1uz;
+				}
+
+				//! returns the size of the subtree if it is small enough to be a single item
+				inline auto split(parser::ASTNode& node) noexcept -> std::optional<std::size_t> {
+					node.visit(*this);
+					const std::optional<std::size_t> size {m_subtreeSize};
+					if (size)
+						m_items.push_back({.node = &node, .nodeCount = *size, .isWholeSubtree = true});
+					return size;
+				}
+
+				inline auto getItems() noexcept -> std::vector<parser::ParallelTraversalItem>& {
+					return m_items;
+				}
+
+			private:
+				inline auto mergeIfSmallEnough(std::size_t firstItem, std::optional<std::size_t> size) noexcept -> void {
+					if (!size || *size > m_maxSubtreeSize) {
+						m_subtreeSize = std::nullopt;
+						return;
+					}
+					m_items.resize(firstItem);
+					m_subtreeSize = size;
+				}
+
+				std::size_t m_maxSubtreeSize;
+				std::optional<std::size_t> m_subtreeSize;
+				std::vector<parser::ParallelTraversalItem> m_items;
+		};
+	}
+
+
+	auto splitForParallelTraversal(parser::ASTNode& root, std::size_t taskSize) noexcept
+		-> std::vector<parser::ParallelTraversalTask>
+	{
+		taskSize = std::max(taskSize, 1uz);
+		BoundedSizeVisitor sizeVisitor {taskSize};
+		root.visit(sizeVisitor);
+		if (!sizeVisitor.isLarger()) {
+			return {parser::ParallelTraversalTask{
+				.items = {{.node = &root, .nodeCount = sizeVisitor.getCount(), .isWholeSubtree = true}},
+				.nodeCount = sizeVisitor.getCount()
+			}};
+		}
+
+		ParallelSplitVisitor splitVisitor {taskSize};
+		splitVisitor.split(root);
+
+		// consecutive items are packed together, so that small siblings don't each get their own task
+		std::vector<parser::ParallelTraversalTask> tasks {};
+		for (const auto& item : splitVisitor.getItems()) {
+			if (tasks.empty() || tasks.back().nodeCount + item.nodeCount > taskSize)
+				tasks.push_back({.items = {}, .nodeCount = 0uz});
+			tasks.back().items.push_back(item);
+			tasks.back().nodeCount += item.nodeCount;
+		}
+		return tasks;
+	}
 }
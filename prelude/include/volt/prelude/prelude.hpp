@@ -0,0 +1,24 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+#include "volt/lx/token.hpp"
+#include "volt/prelude/export.hpp"
+
+
+namespace volt::prelude {
+	/**
+	 * @brief A module of the prelude, lexed at build time
+	 *
+	 * The source and the tokens live in the read-only data of the library. The metadata of the
+	 * tokens point inside `source`.
+	 * */
+	struct Module {
+		std::u8string_view name;
+		std::u8string_view source;
+		std::span<const lx::Token> tokens;
+	};
+
+	VOLT_PRELUDE_EXPORT auto getModules() noexcept -> std::span<const prelude::Module>;
+}
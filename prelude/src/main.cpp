@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <print>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <volt/lx/lexer.hpp>
+#include <volt/lx/token.hpp>
+
+
+auto readFile(const std::filesystem::path& path) -> std::u8string {
+	std::ifstream file {path, std::ios::binary};
+	const std::string content {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+	return std::u8string{content.begin(), content.end()};
+}
+
+auto writeModule(std::ostream& output, std::size_t moduleIndex, const std::u8string& source) -> bool {
+	std::print(output, "\t\tconstexpr char8_t source{}[] {{", moduleIndex);
+	for (const char8_t byte : source)
+		std::print(output, "{:#x}, ", static_cast<unsigned int> (byte));
+	std::println(output, "0x0}};");
+
+	std::vector<volt::lx::Token> tokens {};
+	for (const auto& token : volt::lx::lex(source))
+		tokens.push_back(token);
+
+	std::println(output, "\t\tconstexpr std::array<lx::Token, {}> tokens{} {{", tokens.size(), moduleIndex);
+	for (const auto& token : tokens) {
+		std::print(output, "\t\t\tlx::Token{{.type = static_cast<lx::TokenType> ({:#x}), .metadata = ",
+			std::to_underlying(*token.type)
+		);
+		if (const auto* text {std::get_if<std::u8string_view> (&token.metadata)}; text != nullptr) {
+			const auto offset {static_cast<std::size_t> (text->data() - source.data())};
+			if (text->data() < source.data() || offset + text->size() > source.size()) {
+				std::println(stderr, "Token metadata outside of the prelude source");
+				return false;
+			}
+			std::println(output, "std::u8string_view{{source{} + {}, {}}}}},", moduleIndex, offset, text->size());
+		}
+		else
+			std::println(output, "std::monostate{{}}}},");
+	}
+	std::println(output, "\t\t}};");
+	return true;
+}
+
+
+auto main(int argc, char** argv) -> int {
+	if (argc < 2) {
+		std::println(stderr, "Usage: {} <output> [prelude sources...]", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream output {argv[1]};
+	if (!output) {
+		std::println(stderr, "Can't open output file '{}'", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	std::println(output, "// generated by prelude-generator, do not edit");
+	std::println(output, "#include \"volt/prelude/prelude.hpp\"\n");
+	std::println(output, "#include <array>\n#include <string_view>\n#include <variant>\n");
+	std::println(output, "namespace volt::prelude {{\n\tnamespace {{");
+
+	std::vector<std::pair<std::string, std::size_t>> modules {};
+	for (int i {2}; i < argc; ++i) {
+		const std::filesystem::path path {argv[i]};
+		if (!std::filesystem::is_regular_file(path)) {
+			std::println(stderr, "Can't open prelude source '{}'", argv[i]);
+			return EXIT_FAILURE;
+		}
+		const std::u8string source {readFile(path)};
+		if (!writeModule(output, modules.size(), source))
+			return EXIT_FAILURE;
+		modules.emplace_back(path.stem().string(), source.size());
+	}
+
+	std::println(output, "\t\tconstexpr std::array<prelude::Module, {}> modules {{", modules.size());
+	for (const auto& [i, nameAndSize] : modules | std::views::enumerate) {
+		std::println(output, "\t\t\tprelude::Module{{.name = u8\"{}\", .source = {{source{}, {}}}, .tokens = tokens{}}},",
+			nameAndSize.first, i, nameAndSize.second, i
+		);
+	}
+	std::println(output, "\t\t}};\n\t}}\n");
+	std::println(output, "\tauto getModules() noexcept -> std::span<const prelude::Module> {{\n\t\treturn modules;\n\t}}\n}}");
+	return EXIT_SUCCESS;
+}